@@ -0,0 +1,97 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Compares joining many strings
+// by interspersing the separator and concatenating the result,
+// with fplus::join, which calculates the size of the result first,
+// and with fplus::join_into, which reuses the same output string.
+// The number of heap allocations per join is counted
+// by replacing the global operator new.
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* const p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+typedef std::vector<std::string> Strings;
+
+std::string join_interspersed(const std::string& separator, const Strings& strs)
+{
+    return fplus::concat(fplus::intersperse(separator, strs));
+}
+
+void run_n_times(std::function<std::size_t()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    const std::size_t allocationsBefore = allocations;
+    Time startTime = std::chrono::system_clock::now();
+    std::size_t lengthSum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        lengthSum += f();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << lengthSum << "), elapsed time: " << elapsed_seconds.count() << "s"
+              << ", allocations per join: " << (allocations - allocationsBefore) / n << "\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    // One million words of different lengths.
+    Strings words;
+    for (std::size_t i = 0; i < 1000000; ++i) {
+        words.push_back(std::string(i % 13 + 1, static_cast<char>('a' + i % 26)));
+    }
+    const std::string separator = ", ";
+
+    run_n_times([&]() {
+        return join_interspersed(separator, words).size();
+    },
+        numRuns, "concat(intersperse(...))");
+    run_n_times([&]() {
+        return fplus::join(separator, words).size();
+    },
+        numRuns, "fplus::join");
+    std::string joined;
+    run_n_times([&]() {
+        fplus::join_into(separator, words, joined);
+        return joined.size();
+    },
+        numRuns, "fplus::join_into reused string");
+}
@@ -0,0 +1,101 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compares element-wise operations and reductions
+// on a 2048 x 2048 table of floats stored as nested std::vectors
+// with the same operations on a fplus::matrix.
+
+typedef std::vector<float> Row;
+typedef std::vector<Row> Rows;
+
+void run_n_times(std::function<float()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    float check = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        check += f();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << check << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    const std::size_t n = 2048;
+    Rows rows(n, Row(n));
+    for (std::size_t row = 0; row < n; ++row) {
+        for (std::size_t col = 0; col < n; ++col) {
+            rows[row][col] = static_cast<float>((row * 7 + col) % 101) / 100.0f;
+        }
+    }
+    const auto m = fplus::matrix_from_rows(rows);
+    const auto scale = [](float x) { return 3.0f * x + 1.0f; };
+
+    run_n_times([&]() {
+        return fplus::transform(fplus::fwd::transform(scale), rows)[1][2];
+    },
+        numRuns, "transform nested vectors");
+    run_n_times([&]() {
+        return fplus::transform(scale, m)(1, 2);
+    },
+        numRuns, "transform matrix");
+    run_n_times([&]() {
+        return fplus::sum(fplus::transform(fplus::sum<Row>, rows));
+    },
+        numRuns, "sum nested vectors");
+    run_n_times([&]() {
+        return fplus::reduce(std::plus<float>(), 0.0f, m);
+    },
+        numRuns, "reduce matrix");
+    run_n_times([&]() {
+        const auto add_row = [](const Row& acc, const Row& row) {
+            return fplus::zip_with(std::plus<float>(), acc, row);
+        };
+        return fplus::fold_left(add_row, Row(n, 0.0f), rows)[3];
+    },
+        numRuns, "column sums nested vectors");
+    run_n_times([&]() {
+        return fplus::reduce_cols(std::plus<float>(), 0.0f, m)[3];
+    },
+        numRuns, "column sums matrix");
+    run_n_times([&]() {
+        return fplus::sum(fplus::zip_with([](const Row& xs, const Row& ys) {
+            return fplus::inner_product(0.0f, xs, ys);
+        },
+            rows, rows));
+    },
+        numRuns, "inner_product nested vectors");
+    run_n_times([&]() {
+        return fplus::inner_product(0.0f, m, m);
+    },
+        numRuns, "inner_product matrix");
+    run_n_times([&]() {
+        return fplus::mean_stddev<float>(fplus::concat(rows)).second;
+    },
+        numRuns, "mean_stddev concatenated vectors");
+    run_n_times([&]() {
+        return fplus::mean_stddev<float>(m).second;
+    },
+        numRuns, "mean_stddev matrix");
+}
@@ -0,0 +1,85 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compares calculating the mean and the standard deviation
+// of ten million doubles
+// by summing up the values and then the squares of the differences
+// stored in a temporary vector (the former fplus::mean_stddev),
+// with fplus::mean_stddev on a vector and on a list,
+// and with fplus::mean_stddev_parallelly.
+
+typedef std::vector<double> Doubles;
+
+std::pair<double, double> mean_stddev_with_temporary(const Doubles& xs)
+{
+    const double mean = std::accumulate(xs.begin(), xs.end(), 0.0)
+        / static_cast<double>(xs.size());
+    Doubles diff(xs.size());
+    std::transform(xs.begin(), xs.end(), diff.begin(),
+        [mean](double x) { return x - mean; });
+    const double sq_sum = std::inner_product(
+        diff.begin(), diff.end(), diff.begin(), 0.0);
+    return std::make_pair(mean, std::sqrt(sq_sum / static_cast<double>(xs.size())));
+}
+
+void run_n_times(std::function<double()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    double check = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        check += f();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << check << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    Doubles xs;
+    for (std::size_t i = 0; i < 10000000; ++i) {
+        xs.push_back(static_cast<double>((i * 7919) % 1000) / 10.0 + 1000.0);
+    }
+    const std::list<double> xs_list(xs.begin(), xs.end());
+
+    run_n_times([&]() {
+        return mean_stddev_with_temporary(xs).second;
+    },
+        numRuns, "sum, temporary differences, inner_product");
+    run_n_times([&]() {
+        return fplus::mean_stddev<double>(xs).second;
+    },
+        numRuns, "fplus::mean_stddev vector");
+    run_n_times([&]() {
+        return fplus::mean_stddev<double>(xs_list).second;
+    },
+        numRuns, "fplus::mean_stddev list");
+    run_n_times([&]() {
+        return fplus::mean_stddev_parallelly<double>(xs).second;
+    },
+        numRuns, "fplus::mean_stddev_parallelly vector");
+}
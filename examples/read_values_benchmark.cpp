@@ -0,0 +1,70 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compares parsing a CSV column of doubles
+// by copying every field into a std::string for std::stod
+// with parsing views of the fields using read_values.
+// std::from_chars is only used when compiling as C++17 or newer.
+
+typedef std::vector<double> Doubles;
+
+Doubles read_values_stod(const std::vector<std::string>& strs)
+{
+    Doubles result;
+    result.reserve(strs.size());
+    for (const auto& str : strs) {
+        std::size_t num_chars_used = 0;
+        result.push_back(std::stod(str, &num_chars_used));
+    }
+    return result;
+}
+
+void run_n_times(std::function<Doubles()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += fplus::sum(f());
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << sum << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    std::string column;
+    for (std::size_t i = 0; i < 1000000; ++i) {
+        column += fplus::show(static_cast<double>(i % 1000) / 7.0) + "\n";
+    }
+    const auto fields = fplus::split_lines_views(false, column);
+    const auto field_strings = fplus::split_lines(false, column);
+    std::cout << "fields: " << fields.size() << "\n";
+
+    run_n_times([&]() { return read_values_stod(field_strings); },
+        numRuns, "std::stod on std::strings");
+    run_n_times([&]() { return fplus::transform(fplus::read_value_unsafe<double>, field_strings); },
+        numRuns, "fplus::read_value_unsafe on std::strings");
+    run_n_times([&]() { return fplus::read_values<double>(fields).unsafe_get_just(); },
+        numRuns, "fplus::read_values on views");
+}
@@ -0,0 +1,92 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compares showing vectors of doubles
+// by streaming every element into its own std::ostringstream
+// and joining the results
+// with fplus::show and with appending to one buffer using fplus::show_into.
+// std::to_chars is only used when compiling as C++17 or newer.
+
+typedef std::vector<double> Doubles;
+
+std::string show_doubles_streamed(const Doubles& xs)
+{
+    std::vector<std::string> strs;
+    strs.reserve(xs.size());
+    for (const auto x : xs) {
+        std::ostringstream ss;
+        ss << x;
+        strs.push_back(ss.str());
+    }
+    return "[" + fplus::join(std::string(", "), strs) + "]";
+}
+
+void run_n_times(std::function<std::size_t()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    std::size_t lengthSum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        lengthSum += f();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << lengthSum << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    // A report with 1000 rows of 1000 measurements each.
+    std::vector<Doubles> rows;
+    for (std::size_t row = 0; row < 1000; ++row) {
+        Doubles xs;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            xs.push_back(static_cast<double>(row * i % 997) / 7.0 - 50.0);
+        }
+        rows.push_back(xs);
+    }
+
+    run_n_times([&]() {
+        std::size_t size = 0;
+        for (const auto& xs : rows)
+            size += show_doubles_streamed(xs).size();
+        return size;
+    },
+        numRuns, "std::ostringstream per element and join");
+    run_n_times([&]() {
+        std::size_t size = 0;
+        for (const auto& xs : rows)
+            size += fplus::show(xs).size();
+        return size;
+    },
+        numRuns, "fplus::show");
+    run_n_times([&]() {
+        std::string report;
+        for (const auto& xs : rows) {
+            fplus::show_into(report, xs);
+            report += '\n';
+        }
+        return report.size() - rows.size();
+    },
+        numRuns, "fplus::show_into one buffer");
+}
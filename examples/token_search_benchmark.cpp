@@ -0,0 +1,85 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compares the token search of FunctionalPlus
+// with checking every offset using std::equal
+// on a log of a few megabytes.
+
+typedef std::vector<std::size_t> Idxs;
+
+template <typename Container>
+Idxs find_all_instances_of_token_naive(const Container& token, const Container& xs)
+{
+    Idxs result;
+    if (token.size() > xs.size())
+        return result;
+    for (std::size_t idx = 0; idx <= xs.size() - token.size(); ++idx) {
+        const auto it = std::begin(xs) + static_cast<std::ptrdiff_t>(idx);
+        if (std::equal(std::begin(token), std::end(token), it))
+            result.push_back(idx);
+    }
+    return result;
+}
+
+void run_n_times(std::function<Idxs()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    std::size_t lengthSum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        lengthSum += f().size();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << lengthSum << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+std::string make_log(std::size_t lines)
+{
+    std::string log;
+    for (std::size_t i = 0; i < lines; ++i) {
+        log += "2024-01-01T12:00:" + fplus::show(i % 60)
+            + " INFO worker-" + fplus::show(i % 16)
+            + " request handled in " + fplus::show(i % 1000) + "ms\n";
+        if (i % 10000 == 0)
+            log += "2024-01-01T12:00:00 ERROR connection reset by peer\n";
+    }
+    return log;
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    const std::string log = make_log(100000);
+    const std::vector<char> log_vec(std::begin(log), std::end(log));
+    std::cout << "log size: " << log.size() << " bytes\n";
+
+    for (const std::string token : { "ERROR", "connection reset by peer", "\n" }) {
+        const std::vector<char> token_vec(std::begin(token), std::end(token));
+        std::cout << "token: " << fplus::show(fplus::replace_tokens<std::string>("\n", "\\n", token)) << "\n";
+        run_n_times([&]() { return find_all_instances_of_token_naive(token, log); },
+            numRuns, "  std::equal at every offset, std::string");
+        run_n_times([&]() { return fplus::find_all_instances_of_token(token, log); },
+            numRuns, "  fplus::find_all_instances_of_token, std::string");
+        run_n_times([&]() { return fplus::find_all_instances_of_token(token_vec, log_vec); },
+            numRuns, "  fplus::find_all_instances_of_token, std::vector<char>");
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fplus/fplus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compares transposing a 4096 x 4096 table
+// by splitting an interleaved copy of the rows (the generic fplus::transpose),
+// tile by tile with the fplus::transpose overload for nested std::vectors,
+// as a fplus::matrix, and as a fplus::matrix in place.
+
+typedef std::vector<float> Row;
+typedef std::vector<Row> Rows;
+
+void run_n_times(std::function<float()> f, std::size_t n, const std::string& name)
+{
+    typedef std::chrono::time_point<std::chrono::system_clock> Time;
+    Time startTime = std::chrono::system_clock::now();
+    float check = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        check += f();
+    }
+    Time endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+    std::cout << name << " (check: " << check << "), elapsed time: " << elapsed_seconds.count() << "s\n";
+}
+
+int main()
+{
+    // make debug runs faster
+#if defined NDEBUG || defined _DEBUG
+    std::size_t numRuns = 1;
+#else
+    std::size_t numRuns = 10;
+#endif
+
+    const std::size_t n = 4096;
+    Rows rows(n, Row(n));
+    fplus::matrix<float> m(n, n);
+    for (std::size_t row = 0; row < n; ++row) {
+        for (std::size_t col = 0; col < n; ++col) {
+            rows[row][col] = static_cast<float>((row * 7 + col) % 101);
+            m(row, col) = rows[row][col];
+        }
+    }
+
+    run_n_times([&]() {
+        return fplus::internal::transpose_interleaved(rows)[1][2];
+    },
+        numRuns, "split_every(interleave(rows))");
+    run_n_times([&]() {
+        return fplus::transpose(rows)[1][2];
+    },
+        numRuns, "fplus::transpose vector<vector<float>>");
+    run_n_times([&]() {
+        return fplus::transpose(m)(1, 2);
+    },
+        numRuns, "fplus::transpose matrix<float>");
+    run_n_times([&]() {
+        m = fplus::transpose(std::move(m));
+        return m(1, 2);
+    },
+        numRuns, "fplus::transpose matrix<float> in place");
+}
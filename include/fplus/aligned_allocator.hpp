@@ -0,0 +1,73 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace fplus {
+
+// An allocator returning memory aligned to Alignment bytes,
+// e.g., to the size of a cache line or of the widest SIMD register.
+// std::vector<float, aligned_allocator<float, 64>> xs;
+// Functions creating new containers from such a vector keep the alignment.
+template <typename T, std::size_t Alignment>
+class aligned_allocator {
+public:
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+        "Alignment must be a power of two.");
+    typedef T value_type;
+    template <typename U>
+    struct rebind {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator() = default;
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&)
+    {
+    }
+
+    // The pointer returned by operator new is stored
+    // right in front of the aligned block.
+    T* allocate(std::size_t n)
+    {
+        const std::size_t overhead = Alignment - 1 + sizeof(void*);
+        if (n > (std::numeric_limits<std::size_t>::max() - overhead) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void* const raw = ::operator new(n * sizeof(T) + overhead);
+        const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        const std::uintptr_t aligned = (first + Alignment - 1) & ~std::uintptr_t(Alignment - 1);
+        unsigned char* const result = reinterpret_cast<unsigned char*>(aligned);
+        std::memcpy(result - sizeof(void*), &raw, sizeof(void*));
+        return reinterpret_cast<T*>(result);
+    }
+    void deallocate(T* p, std::size_t)
+    {
+        void* raw = nullptr;
+        std::memcpy(&raw, reinterpret_cast<unsigned char*>(p) - sizeof(void*), sizeof(void*));
+        ::operator delete(raw);
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&)
+{
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&)
+{
+    return false;
+}
+
+} // namespace fplus
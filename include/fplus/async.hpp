@@ -0,0 +1,472 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <fplus/internal/invoke.hpp>
+#include <fplus/maybe.hpp>
+#include <fplus/side_effects.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fplus {
+
+// A fixed number of worker threads processing a shared job queue.
+// The destructor finishes all queued jobs before joining the workers.
+// An exception escaping a job is discarded, so the worker keeps running.
+// To get hold of it, use execute_async instead of post.
+class thread_pool {
+public:
+    explicit thread_pool(std::size_t n_threads)
+        : mutex_()
+        , cond_()
+        , jobs_()
+        , quit_(false)
+        , threads_()
+    {
+        try {
+            for (std::size_t i = 0; i < std::max<std::size_t>(1, n_threads); ++i) {
+                threads_.emplace_back([this]() { worker_function(); });
+            }
+        } catch (...) {
+            // Not being able to spawn a thread must not leave
+            // the ones already running unjoined.
+            stop_and_join();
+            throw;
+        }
+    }
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    ~thread_pool()
+    {
+        stop_and_join();
+    }
+    void post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        cond_.notify_one();
+    }
+    std::size_t size() const
+    {
+        return threads_.size();
+    }
+
+private:
+    void stop_and_join()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        cond_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+    void worker_function()
+    {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this]() { return quit_ || !jobs_.empty(); });
+                if (jobs_.empty()) {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            try {
+                job();
+            } catch (...) {
+            }
+        }
+    }
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> jobs_;
+    bool quit_;
+    std::vector<std::thread> threads_;
+};
+
+// The pool shared by all async_futures,
+// sized to the number of hardware threads.
+inline thread_pool& default_thread_pool()
+{
+    static thread_pool pool(
+        std::max<std::size_t>(2, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+template <typename T>
+class async_future;
+
+template <typename T>
+class async_promise;
+
+namespace internal {
+
+    template <typename T>
+    class async_state {
+    public:
+        async_state()
+            : mutex_()
+            , cond_()
+            , value_()
+            , exception_()
+            , ready_(false)
+            , continuations_()
+        {
+        }
+        void set_value(T value)
+        {
+            set([&]() { value_ = maybe<T>(std::move(value)); });
+        }
+        void set_exception(std::exception_ptr e)
+        {
+            set([&]() { exception_ = e; });
+        }
+        // Fails the state with broken_promise unless it is ready already.
+        void abandon()
+        {
+            std::vector<std::function<void()>> continuations;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (ready_) {
+                    return;
+                }
+                exception_ = std::make_exception_ptr(
+                    std::future_error(std::future_errc::broken_promise));
+                ready_ = true;
+                continuations.swap(continuations_);
+            }
+            notify(continuations);
+        }
+        bool is_ready()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return ready_;
+        }
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return ready_; });
+        }
+        T get()
+        {
+            wait();
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+            return value_.unsafe_get_just();
+        }
+        // Only to be called once the state is ready.
+        const maybe<T>& value() const { return value_; }
+        std::exception_ptr exception() const { return exception_; }
+
+        // The continuation is posted to the default pool
+        // as soon as the state becomes ready.
+        void on_ready(std::function<void()> continuation)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!ready_) {
+                    continuations_.push_back(std::move(continuation));
+                    return;
+                }
+            }
+            default_thread_pool().post(std::move(continuation));
+        }
+
+    private:
+        template <typename Setter>
+        void set(Setter setter)
+        {
+            std::vector<std::function<void()>> continuations;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (ready_) {
+                    throw std::future_error(
+                        std::future_errc::promise_already_satisfied);
+                }
+                setter();
+                ready_ = true;
+                continuations.swap(continuations_);
+            }
+            notify(continuations);
+        }
+        void notify(std::vector<std::function<void()>>& continuations)
+        {
+            cond_.notify_all();
+            for (auto& continuation : continuations) {
+                default_thread_pool().post(std::move(continuation));
+            }
+        }
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        maybe<T> value_;
+        std::exception_ptr exception_;
+        bool ready_;
+        std::vector<std::function<void()>> continuations_;
+    };
+
+    // Effects returning void are treated as returning true,
+    // so every async_future holds a value.
+    template <typename F, typename... Args>
+    auto invoke_non_void(std::true_type, F& f, Args&&... args)
+    {
+        internal::invoke(f, std::forward<Args>(args)...);
+        return true;
+    }
+
+    template <typename F, typename... Args>
+    auto invoke_non_void(std::false_type, F& f, Args&&... args)
+    {
+        return internal::invoke(f, std::forward<Args>(args)...);
+    }
+
+    template <typename F, typename... Args>
+    auto invoke_non_void(F& f, Args&&... args)
+    {
+        return invoke_non_void(
+            std::is_void<internal::invoke_result_t<F, Args...>>(),
+            f, std::forward<Args>(args)...);
+    }
+
+    template <typename F, typename... Args>
+    using invoke_non_void_result_t = std::decay_t<decltype(invoke_non_void(
+        std::declval<F&>(), std::declval<Args>()...))>;
+
+    // Owned by all copies of an async_promise,
+    // breaks the promise when the last of them goes away.
+    template <typename T>
+    class async_promise_owner {
+    public:
+        async_promise_owner()
+            : state_(std::make_shared<async_state<T>>())
+        {
+        }
+        async_promise_owner(const async_promise_owner&) = delete;
+        async_promise_owner& operator=(const async_promise_owner&) = delete;
+        ~async_promise_owner()
+        {
+            state_->abandon();
+        }
+        const std::shared_ptr<async_state<T>>& state() const { return state_; }
+
+    private:
+        std::shared_ptr<async_state<T>> state_;
+    };
+
+    // Grants the implementation access to the state behind a future.
+    struct async_access {
+        template <typename T>
+        static async_future<T> make_future(std::shared_ptr<async_state<T>> state)
+        {
+            return async_future<T>(state);
+        }
+        template <typename T>
+        static std::shared_ptr<async_state<T>> get_state(const async_future<T>& future)
+        {
+            return future.state_;
+        }
+    };
+
+    template <typename T, typename F>
+    void fulfill_with(const std::shared_ptr<async_state<T>>& state, F f)
+    {
+        try {
+            state->set_value(f());
+        } catch (...) {
+            state->set_exception(std::current_exception());
+        }
+    }
+
+} // namespace internal
+
+// The result of a computation running on the default thread pool.
+// Copies share their state.
+// Instead of blocking with get(), further work can be chained with then(),
+// which does not occupy a thread while waiting.
+// Calling get() from inside a job running on the pool can deadlock
+// if all pool threads are waiting this way, so prefer then() there.
+template <typename T>
+class async_future {
+public:
+    typedef T value_type;
+
+    bool is_ready() const { return state_->is_ready(); }
+    void wait() const { state_->wait(); }
+    // Blocks until the value is available.
+    // Rethrows the exception if the computation failed.
+    T get() const { return state_->get(); }
+
+    // Returns a future holding f applied to the value of this one.
+    // An exception of this future is passed on without calling f.
+    template <typename F>
+    auto then(F f) const
+    {
+        using U = internal::invoke_non_void_result_t<F, const T&>;
+        auto source = state_;
+        auto target = std::make_shared<internal::async_state<U>>();
+        source->on_ready([source, target, f]() mutable {
+            if (source->exception()) {
+                target->set_exception(source->exception());
+                return;
+            }
+            internal::fulfill_with(target, [&]() {
+                return internal::invoke_non_void(
+                    f, source->value().unsafe_get_just());
+            });
+        });
+        return internal::async_access::make_future(target);
+    }
+
+private:
+    friend struct internal::async_access;
+    explicit async_future(std::shared_ptr<internal::async_state<T>> state)
+        : state_(state)
+    {
+    }
+    std::shared_ptr<internal::async_state<T>> state_;
+};
+
+// The producing side of an async_future,
+// for results that are not computed by a function on the pool,
+// e.g., ones delivered by a callback-based I/O library.
+// Copies share their state.
+// Setting a value or an exception a second time
+// throws std::future_error (promise_already_satisfied).
+// If the last copy is destroyed without either being set,
+// the future fails with std::future_error (broken_promise).
+template <typename T>
+class async_promise {
+public:
+    async_promise()
+        : owner_(std::make_shared<internal::async_promise_owner<T>>())
+    {
+    }
+    async_future<T> get_future() const { return internal::async_access::make_future(owner_->state()); }
+    void set_value(T value) const { owner_->state()->set_value(std::move(value)); }
+    void set_exception(std::exception_ptr e) const { owner_->state()->set_exception(e); }
+
+private:
+    std::shared_ptr<internal::async_promise_owner<T>> owner_;
+};
+
+// API search type: execute_async : Io a -> AsyncFuture a
+// Runs the given side effect on the default thread pool
+// and returns a future for its result.
+// Effects returning void result in a future holding true.
+// Works with all effects, e.g., the ones returned by
+// execute_serially or execute_max_n_times_until_success.
+template <typename Effect>
+auto execute_async(Effect eff)
+{
+    using T = internal::invoke_non_void_result_t<Effect>;
+    auto state = std::make_shared<internal::async_state<T>>();
+    default_thread_pool().post([state, eff]() mutable {
+        internal::fulfill_with(state, [&]() {
+            return internal::invoke_non_void(eff);
+        });
+    });
+    return internal::async_access::make_future(state);
+}
+
+// API search type: when_all : [AsyncFuture a] -> AsyncFuture [a]
+// Returns a future that becomes ready when all given futures are.
+// It holds all values in the original order
+// or the exception of the first failed future (by position).
+template <typename Container>
+auto when_all(const Container& futures)
+{
+    using T = typename Container::value_type::value_type;
+    using States = std::vector<std::shared_ptr<internal::async_state<T>>>;
+    auto target = std::make_shared<internal::async_state<std::vector<T>>>();
+    auto states = std::make_shared<States>();
+    for (const auto& future : futures) {
+        states->push_back(internal::async_access::get_state(future));
+    }
+    if (states->empty()) {
+        target->set_value(std::vector<T>());
+        return internal::async_access::make_future(target);
+    }
+    auto remaining = std::make_shared<std::atomic<std::size_t>>(states->size());
+    for (const auto& state : *states) {
+        state->on_ready([states, remaining, target]() {
+            if (remaining->fetch_sub(1) != 1) {
+                return;
+            }
+            for (const auto& s : *states) {
+                if (s->exception()) {
+                    target->set_exception(s->exception());
+                    return;
+                }
+            }
+            internal::fulfill_with(target, [&]() {
+                std::vector<T> values;
+                values.reserve(states->size());
+                for (const auto& s : *states) {
+                    values.push_back(s->value().unsafe_get_just());
+                }
+                return values;
+            });
+        });
+    }
+    return internal::async_access::make_future(target);
+}
+
+// API search type: when_any : [AsyncFuture a] -> AsyncFuture (Int, a)
+// Returns a future that becomes ready as soon as one of the given futures is.
+// It holds the index and the value of this future,
+// or its exception if it failed.
+// The given container must not be empty.
+template <typename Container>
+auto when_any(const Container& futures)
+{
+    using T = typename Container::value_type::value_type;
+    using Result = std::pair<std::size_t, T>;
+    assert(!futures.empty());
+    auto target = std::make_shared<internal::async_state<Result>>();
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    std::size_t idx = 0;
+    for (const auto& future : futures) {
+        const auto state = internal::async_access::get_state(future);
+        state->on_ready([state, idx, done, target]() {
+            if (done->exchange(true)) {
+                return;
+            }
+            if (state->exception()) {
+                target->set_exception(state->exception());
+                return;
+            }
+            internal::fulfill_with(target, [&]() {
+                return Result(idx, state->value().unsafe_get_just());
+            });
+        });
+        ++idx;
+    }
+    return internal::async_access::make_future(target);
+}
+
+} // namespace fplus
@@ -0,0 +1,83 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <fplus/maybe.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace fplus {
+
+// Can be used to stop long-running (parallel) algorithms early.
+// Copies share their state, so one copy can be handed to
+// the algorithm while another one is used to call cancel().
+// Optionally carries a deadline, after which it counts as cancelled too.
+// Running function calls are not interrupted,
+// but no new ones are started once the token is cancelled.
+// Functions doing a lot of work per call
+// can also poll is_cancelled() themselves.
+//
+// Example usage:
+//
+// const auto token = cancellation_token::with_timeout_ms(200);
+// const auto ys = transform_parallelly_n_threads_cancellable(
+//     token, 4, slow_f, xs);
+// if (is_error(ys)) { ... }
+class cancellation_token {
+public:
+    typedef std::chrono::steady_clock clock;
+    typedef clock::time_point time_point;
+
+    cancellation_token()
+        : cancelled_(std::make_shared<std::atomic<bool>>(false))
+        , deadline_()
+    {
+    }
+    explicit cancellation_token(time_point deadline)
+        : cancelled_(std::make_shared<std::atomic<bool>>(false))
+        , deadline_(just(deadline))
+    {
+    }
+    static cancellation_token with_timeout_ms(std::size_t milliseconds)
+    {
+        return cancellation_token(clock::now() + std::chrono::milliseconds(milliseconds));
+    }
+    void cancel() const
+    {
+        cancelled_->store(true);
+    }
+    bool is_cancelled() const
+    {
+        return cancelled_->load() || deadline_exceeded();
+    }
+    bool deadline_exceeded() const
+    {
+        return deadline_.is_just() && clock::now() >= deadline_.unsafe_get_just();
+    }
+    maybe<time_point> deadline() const
+    {
+        return deadline_;
+    }
+    // Error message describing why the token counts as cancelled.
+    std::string reason() const
+    {
+        if (deadline_exceeded() && !cancelled_->load()) {
+            return "deadline exceeded";
+        }
+        return "cancelled";
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    maybe<time_point> deadline_;
+};
+
+} // namespace fplus
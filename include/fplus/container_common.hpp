@@ -16,11 +16,22 @@
 #include <fplus/internal/meta.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <deque>
+#include <functional>
 #include <iterator>
+#include <list>
 #include <numeric>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace fplus {
 
@@ -63,16 +74,21 @@ namespace internal {
     // In VC2015, release mode, Celsius W520 Xeon
     // this leads to an increase in performance of about a factor of 3
     // for transform.
-    template <typename C>
-    void prepare_container(const std::basic_string<C, std::char_traits<C>,
-                               std::allocator<C>>& ys,
+    template <typename C, typename Traits, typename Alloc>
+    void prepare_container(std::basic_string<C, Traits, Alloc>& ys,
         std::size_t size)
     {
         ys.reserve(size);
     }
 
-    template <typename Y>
-    void prepare_container(std::vector<Y>& ys, std::size_t size)
+    template <typename Y, typename Alloc>
+    void prepare_container(std::vector<Y, Alloc>& ys, std::size_t size)
+    {
+        ys.reserve(size);
+    }
+
+    template <typename Y, std::size_t N>
+    void prepare_container(small_vector<Y, N>& ys, std::size_t size)
     {
         ys.reserve(size);
     }
@@ -84,26 +100,26 @@ namespace internal {
         unused(size);
     }
 
-    template <typename Y>
-    void prepare_container(std::unordered_set<Y>& ys, std::size_t size)
+    template <typename Y, typename Hash, typename Pred, typename Alloc>
+    void prepare_container(std::unordered_set<Y, Hash, Pred, Alloc>& ys, std::size_t size)
     {
         ys.reserve(size);
     }
 
-    template <typename Key, typename T>
-    void prepare_container(std::unordered_map<Key, T>& ys, std::size_t size)
+    template <typename Key, typename T, typename Hash, typename Pred, typename Alloc>
+    void prepare_container(std::unordered_map<Key, T, Hash, Pred, Alloc>& ys, std::size_t size)
     {
         ys.reserve(size);
     }
 
-    template <typename Y>
-    void prepare_container(std::unordered_multiset<Y>& ys, std::size_t size)
+    template <typename Y, typename Hash, typename Pred, typename Alloc>
+    void prepare_container(std::unordered_multiset<Y, Hash, Pred, Alloc>& ys, std::size_t size)
     {
         ys.reserve(size);
     }
 
-    template <typename Key, typename T>
-    void prepare_container(std::unordered_multimap<Key, T>& ys, std::size_t size)
+    template <typename Key, typename T, typename Hash, typename Pred, typename Alloc>
+    void prepare_container(std::unordered_multimap<Key, T, Hash, Pred, Alloc>& ys, std::size_t size)
     {
         ys.reserve(size);
     }
@@ -113,26 +129,27 @@ namespace internal {
     {
     }
 
-    template <typename Container>
-    std::back_insert_iterator<Container> get_back_inserter(std::string& ys)
+    template <typename C, typename Traits, typename Alloc>
+    std::back_insert_iterator<std::basic_string<C, Traits, Alloc>> get_back_inserter(
+        std::basic_string<C, Traits, Alloc>& ys)
     {
         return std::back_inserter(ys);
     }
 
-    template <typename Container, typename Y>
-    std::back_insert_iterator<Container> get_back_inserter(std::vector<Y>& ys)
+    template <typename Y, typename Alloc>
+    std::back_insert_iterator<std::vector<Y, Alloc>> get_back_inserter(std::vector<Y, Alloc>& ys)
     {
         return std::back_inserter(ys);
     }
 
-    template <typename Container, typename Y>
-    std::back_insert_iterator<Container> get_back_inserter(std::list<Y>& ys)
+    template <typename Y, typename Alloc>
+    std::back_insert_iterator<std::list<Y, Alloc>> get_back_inserter(std::list<Y, Alloc>& ys)
     {
         return std::back_inserter(ys);
     }
 
-    template <typename Container, typename Y>
-    std::back_insert_iterator<Container> get_back_inserter(std::deque<Y>& ys)
+    template <typename Y, typename Alloc>
+    std::back_insert_iterator<std::deque<Y, Alloc>> get_back_inserter(std::deque<Y, Alloc>& ys)
     {
         return std::back_inserter(ys);
     }
@@ -206,12 +223,96 @@ namespace internal {
         return array_back_insert_iterator<Y, N>(ys);
     }
 
+    template <typename Y, std::size_t N>
+    std::back_insert_iterator<small_vector<Y, N>> get_back_inserter(small_vector<Y, N>& ys)
+    {
+        return std::back_inserter(ys);
+    }
+
     template <typename Container>
     std::insert_iterator<Container> get_back_inserter(Container& ys)
     {
         return std::inserter(ys, std::end(ys));
     }
 
+    // The _into functions write into containers, which are recognized
+    // by having clear(), or else into output iterators.
+    template <typename T, typename = void>
+    struct is_output_container : std::false_type {
+    };
+    template <typename T>
+    struct is_output_container<T,
+        void_t<decltype(std::declval<T&>().clear())>>
+        : std::true_type {
+    };
+
+    template <typename T>
+    using enable_if_output_container_t = std::enable_if_t<is_output_container<T>::value, int>;
+
+    template <typename T>
+    using enable_if_output_iterator_t = std::enable_if_t<!is_output_container<T>::value, int>;
+
+    // New containers use the allocator of the container they are made from
+    // (rebound to their element type) if it is convertible,
+    // so e.g. the results of std::pmr containers
+    // are allocated from the same memory resource.
+    template <typename ContainerOut, typename ContainerIn, typename = void>
+    struct can_inherit_allocator : std::false_type {
+    };
+    template <typename ContainerOut, typename ContainerIn>
+    struct can_inherit_allocator<ContainerOut, ContainerIn,
+        void_t<typename ContainerOut::allocator_type,
+            decltype(std::declval<const ContainerIn&>().get_allocator())>>
+        : std::integral_constant<bool,
+              std::is_constructible<typename ContainerOut::allocator_type,
+                  decltype(std::declval<const ContainerIn&>().get_allocator())>::value
+                  && std::is_constructible<ContainerOut,
+                      const typename ContainerOut::allocator_type&>::value> {
+    };
+
+    template <typename ContainerOut, typename ContainerIn>
+    ContainerOut new_container_like(std::true_type, const ContainerIn& xs)
+    {
+        return ContainerOut(
+            typename ContainerOut::allocator_type(xs.get_allocator()));
+    }
+
+    template <typename ContainerOut, typename ContainerIn>
+    ContainerOut new_container_like(std::false_type, const ContainerIn&)
+    {
+        return ContainerOut();
+    }
+
+    // An empty ContainerOut using the allocator of xs if possible.
+    template <typename ContainerOut, typename ContainerIn>
+    ContainerOut new_container_like(const ContainerIn& xs)
+    {
+        return new_container_like<ContainerOut>(
+            can_inherit_allocator<ContainerOut, ContainerIn> {}, xs);
+    }
+
+    template <typename Container>
+    Container copy_container(std::true_type, const Container& xs)
+    {
+        return Container(xs, xs.get_allocator());
+    }
+
+    template <typename Container>
+    Container copy_container(std::false_type, const Container& xs)
+    {
+        return xs;
+    }
+
+    // Unlike the copy constructor, which asks the allocator
+    // (select_on_container_copy_construction),
+    // this keeps the allocator of xs, e.g. for std::pmr containers.
+    template <typename Container>
+    Container copy_container(const Container& xs)
+    {
+        return copy_container(
+            can_inherit_allocator<Container, Container> {}, xs);
+    }
+
     template <typename Iterator>
     void advance_iterator(Iterator& it, std::size_t distance)
     {
@@ -388,10 +489,10 @@ namespace internal {
         std::size_t idx_begin, std::size_t idx_end, const Container& xs)
     {
         idx_end = std::min(idx_end, size_of_cont(xs));
+        auto result = internal::new_container_like<Container>(xs);
         if (idx_end <= idx_begin) {
-            return {};
+            return result;
         }
-        Container result;
         auto itBegin = std::begin(xs);
         internal::advance_iterator(itBegin, idx_begin);
         auto itEnd = itBegin;
@@ -589,6 +690,33 @@ std::vector<T> elems_at_idxs(const ContainerIdxs& idxs, const Container& xs)
     return result;
 }
 
+// API search type: elems_at_idxs_into : ([Int], [a], [a]) -> ()
+// Same as elems_at_idxs, but writes the elements into ys
+// (a container or an output iterator), like transform_into does.
+template <typename Container, typename ContainerIdxs, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt elems_at_idxs_into(const ContainerIdxs& idxs, const Container& xs,
+    OutputIt it)
+{
+    static_assert(std::is_same<typename ContainerIdxs::value_type, std::size_t>::value,
+        "Indices must be std::size_t");
+    for (std::size_t idx : idxs) {
+        *it = elem_at_idx(idx, xs);
+        ++it;
+    }
+    return it;
+}
+
+template <typename Container, typename ContainerIdxs, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void elems_at_idxs_into(const ContainerIdxs& idxs, const Container& xs,
+    ContainerOut& ys)
+{
+    ys.clear();
+    internal::prepare_container(ys, size_of_cont(idxs));
+    elems_at_idxs_into(idxs, xs, internal::get_back_inserter(ys));
+}
+
 namespace internal {
 
     template <typename Container, typename F>
@@ -608,7 +736,7 @@ namespace internal {
         internal::trigger_static_asserts<internal::unary_function_tag,
             F,
             decltype(*std::begin(xs))>();
-        ContainerOut ys;
+        auto ys = internal::new_container_like<ContainerOut>(xs);
         internal::prepare_container(ys, size_of_cont(xs));
         auto it = internal::get_back_inserter(ys);
         std::transform(std::begin(xs), std::end(xs), it, f);
@@ -652,13 +780,38 @@ template <typename ContainerOut, typename F, typename ContainerIn>
 ContainerOut transform_convert(F f, const ContainerIn& xs)
 {
     internal::trigger_static_asserts<internal::unary_function_tag, F, typename ContainerIn::value_type>();
-    ContainerOut ys;
+    auto ys = internal::new_container_like<ContainerOut>(xs);
     internal::prepare_container(ys, size_of_cont(xs));
     auto it = internal::get_back_inserter(ys);
     std::transform(std::begin(xs), std::end(xs), it, f);
     return ys;
 }
 
+// API search type: transform_into : ((a -> b), [a], [b]) -> ()
+// Same as transform_convert, but writes the results into ys,
+// whose previous elements are removed.
+// The memory of ys is reused, so in a loop with the same ys
+// nothing is allocated once ys is large enough.
+// ys can also be an output iterator, which is returned
+// after the results have been written.
+// ys must not be xs.
+template <typename F, typename ContainerIn, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt transform_into(F f, const ContainerIn& xs, OutputIt it)
+{
+    internal::trigger_static_asserts<internal::unary_function_tag, F, typename ContainerIn::value_type>();
+    return std::transform(std::begin(xs), std::end(xs), it, f);
+}
+
+template <typename F, typename ContainerIn, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void transform_into(F f, const ContainerIn& xs, ContainerOut& ys)
+{
+    ys.clear();
+    internal::prepare_container(ys, size_of_cont(xs));
+    transform_into(f, xs, internal::get_back_inserter(ys));
+}
+
 // API search type: transform_inner : ((a -> b), [[a]]) -> [[b]]
 // fwd bind count: 1
 // Applies a function to the elements of the inner containers
@@ -1141,12 +1294,12 @@ ContainerOut append_elem(const T& y, Container&& xs)
 
 namespace internal {
 
-    template <typename T>
-    std::list<T> prepend_elem(internal::reuse_container_t,
-        const T& y, std::list<T>&& xs)
+    template <typename T, typename Alloc>
+    std::list<T, Alloc> prepend_elem(internal::reuse_container_t,
+        const T& y, std::list<T, Alloc>&& xs)
     {
         xs.push_front(y);
-        return std::forward<std::list<T>>(xs);
+        return std::forward<std::list<T, Alloc>>(xs);
     }
 
     template <typename T, typename Container>
@@ -1212,6 +1365,28 @@ ContainerOut append_convert(const ContainerIn1& xs, const ContainerIn2& ys)
     return append<ContainerIn1, ContainerIn2, ContainerOut>(xs, ys);
 }
 
+// API search type: append_into : ([a], [a], [a]) -> ()
+// Same as append, but writes the result into zs
+// (a container or an output iterator), like transform_into does.
+template <typename ContainerIn1, typename ContainerIn2, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt append_into(const ContainerIn1& xs, const ContainerIn2& ys,
+    OutputIt it)
+{
+    return std::copy(std::begin(ys), std::end(ys),
+        std::copy(std::begin(xs), std::end(xs), it));
+}
+
+template <typename ContainerIn1, typename ContainerIn2, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void append_into(const ContainerIn1& xs, const ContainerIn2& ys,
+    ContainerOut& zs)
+{
+    zs.clear();
+    internal::prepare_container(zs, size_of_cont(xs) + size_of_cont(ys));
+    append_into(xs, ys, internal::get_back_inserter(zs));
+}
+
 // API search type: concat : [[a]] -> [a]
 // fwd bind count: 0
 // Concatenates multiple sequences.
@@ -1223,7 +1398,9 @@ ContainerOut concat(const ContainerIn& xss)
 {
     std::size_t length = sum(
         transform(size_of_cont<typename ContainerIn::value_type>, xss));
-    ContainerOut result;
+    auto result = is_empty(xss)
+        ? ContainerOut()
+        : internal::new_container_like<ContainerOut>(*std::begin(xss));
     internal::prepare_container(result, length);
     using std::begin;
     using std::end;
@@ -1233,6 +1410,32 @@ ContainerOut concat(const ContainerIn& xss)
     return result;
 }
 
+// API search type: concat_into : ([[a]], [a]) -> ()
+// Same as concat, but writes the result into ys
+// (a container or an output iterator), like transform_into does.
+template <typename ContainerIn, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt concat_into(const ContainerIn& xss, OutputIt it)
+{
+    for (const auto& xs : xss) {
+        it = std::copy(std::begin(xs), std::end(xs), it);
+    }
+    return it;
+}
+
+template <typename ContainerIn, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void concat_into(const ContainerIn& xss, ContainerOut& ys)
+{
+    std::size_t length = 0;
+    for (const auto& xs : xss) {
+        length += size_of_cont(xs);
+    }
+    ys.clear();
+    internal::prepare_container(ys, length);
+    concat_into(xss, internal::get_back_inserter(ys));
+}
+
 // API search type: interweave : ([a], [a]) -> [a]
 // fwd bind count: 1
 // Return a sequence that contains elements from the two provided sequences
@@ -1289,19 +1492,19 @@ std::pair<Container, Container> unweave(const Container& xs)
 
 namespace internal {
 
-    template <typename Compare, typename T>
-    std::list<T> sort_by(internal::reuse_container_t, Compare comp,
-        std::list<T>&& xs)
+    template <typename Compare, typename T, typename Alloc>
+    std::list<T, Alloc> sort_by(internal::reuse_container_t, Compare comp,
+        std::list<T, Alloc>&& xs)
     {
         xs.sort(comp);
-        return std::forward<std::list<T>>(xs);
+        return std::forward<std::list<T, Alloc>>(xs);
     }
 
-    template <typename Compare, typename T>
-    std::list<T> sort_by(internal::create_new_container_t, Compare comp,
-        const std::list<T>& xs)
+    template <typename Compare, typename T, typename Alloc>
+    std::list<T, Alloc> sort_by(internal::create_new_container_t, Compare comp,
+        const std::list<T, Alloc>& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         result.sort(comp);
         return result;
     }
@@ -1317,7 +1520,7 @@ namespace internal {
     Container sort_by(internal::create_new_container_t, Compare comp,
         const Container& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         std::sort(std::begin(result), std::end(result), comp);
         return result;
     }
@@ -1391,19 +1594,19 @@ ContainerOut sort(Container&& xs)
 
 namespace internal {
 
-    template <typename Compare, typename T>
-    std::list<T> stable_sort_by(internal::reuse_container_t, Compare comp,
-        std::list<T>&& xs)
+    template <typename Compare, typename T, typename Alloc>
+    std::list<T, Alloc> stable_sort_by(internal::reuse_container_t, Compare comp,
+        std::list<T, Alloc>&& xs)
     {
         xs.sort(comp); // std::list<T>::sort ist already stable.
-        return std::forward<std::list<T>>(xs);
+        return std::forward<std::list<T, Alloc>>(xs);
     }
 
-    template <typename Compare, typename T>
-    std::list<T> stable_sort_by(internal::create_new_container_t, Compare comp,
-        const std::list<T>& xs)
+    template <typename Compare, typename T, typename Alloc>
+    std::list<T, Alloc> stable_sort_by(internal::create_new_container_t, Compare comp,
+        const std::list<T, Alloc>& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         result.sort(comp); // std::list<T>::sort ist already stable.
         return result;
     }
@@ -1420,7 +1623,7 @@ namespace internal {
     Container stable_sort_by(internal::create_new_container_t, Compare comp,
         const Container& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         std::sort(std::begin(result), std::end(result), comp);
         return result;
     }
@@ -1480,7 +1683,7 @@ namespace internal {
     Container partial_sort_by(internal::create_new_container_t, Compare comp,
         std::size_t count, const Container& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         return partial_sort_by(
             internal::reuse_container_t(), comp, count, std::move(result));
     }
@@ -1575,7 +1778,7 @@ namespace internal {
     Container unique_by(internal::create_new_container_t,
         BinaryPredicate pred, const Container& xs)
     {
-        auto result = xs;
+        auto result = internal::copy_container(xs);
         return unique_by(internal::reuse_container_t(), pred, std::move(result));
     }
 
@@ -1652,6 +1855,41 @@ Container intersperse(const X& value, const Container& xs)
     return result;
 }
 
+// API search type: join_into : ([a], [[a]], [a]) -> ()
+// Same as join, but writes the result into ys
+// (a container or an output iterator), like transform_into does.
+// join_into(", ", ["a", "bee", "cee"], str) makes str == "a, bee, cee"
+template <typename Container, typename X, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt join_into(const X& separator, const Container& xs, OutputIt it)
+{
+    bool is_first = true;
+    for (const auto& x : xs) {
+        if (!is_first) {
+            it = std::copy(std::begin(separator), std::end(separator), it);
+        }
+        is_first = false;
+        it = std::copy(std::begin(x), std::end(x), it);
+    }
+    return it;
+}
+
+template <typename Container, typename X, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void join_into(const X& separator, const Container& xs, ContainerOut& ys)
+{
+    std::size_t length = 0;
+    for (const auto& x : xs) {
+        length += size_of_cont(x);
+    }
+    if (!is_empty(xs)) {
+        length += (size_of_cont(xs) - 1) * size_of_cont(separator);
+    }
+    ys.clear();
+    internal::prepare_container(ys, length);
+    join_into(separator, xs, internal::get_back_inserter(ys));
+}
+
 // API search type: join : ([a], [[a]]) -> [a]
 // fwd bind count: 1
 // Inserts a separator sequence in between the elements
@@ -1659,11 +1897,15 @@ Container intersperse(const X& value, const Container& xs)
 // Also known as intercalate or implode.
 // join(", ", ["a", "bee", "cee"]) == "a, bee, cee"
 // join([0, 0], [[1], [2], [3, 4]]) == [1, 0, 0, 2, 0, 0, 3, 4]
+// The size of the result is calculated first,
+// so e.g. a joined string is allocated only once.
 template <typename Container,
     typename X = typename Container::value_type>
 X join(const X& separator, const Container& xs)
 {
-    return concat(intersperse(separator, xs));
+    auto result = internal::new_container_like<X>(separator);
+    join_into(separator, xs, result);
+    return result;
 }
 
 // API search type: join_elem : (a, [[a]]) -> [a]
@@ -1721,42 +1963,168 @@ Container nub_by(BinaryPredicate p, const Container& xs)
     return result;
 }
 
+// API search type: all_unique_by_eq : (((a, a) -> Bool), [a]) -> Bool
+// fwd bind count: 1
+// Checks if all elements in a container are unique
+// with respect to a predicate.
+// Returns true for empty containers.
+// O(n^2)
+template <typename Container, typename BinaryPredicate>
+bool all_unique_by_eq(BinaryPredicate p, const Container& xs)
+{
+    internal::check_binary_predicate_for_container<BinaryPredicate, Container>();
+    for (auto it = std::begin(xs); it != std::end(xs); ++it) {
+        const auto eqToX = bind_1st_of_2(p, *it);
+        if (std::any_of(std::begin(xs), it, eqToX)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace internal {
+
+    template <typename T, typename = void>
+    struct is_hashable : std::false_type {
+    };
+
+    template <typename T>
+    struct is_hashable<T,
+        void_t<decltype(std::hash<T>()(std::declval<const T&>())),
+            decltype(std::declval<const T&>() == std::declval<const T&>())>>
+        : std::true_type {
+    };
+
+    // Types whose operator< is known to consider two values equivalent
+    // exactly if they are equal according to operator==.
+    // This is not the case for floating point numbers (NaN),
+    // or for user-defined types with a custom or partial ordering,
+    // so for those only operator== is used.
+    template <typename T>
+    struct has_ordered_equality
+        : std::integral_constant<bool,
+              std::is_integral<T>::value || std::is_enum<T>::value> {
+    };
+
+    template <typename C, typename Traits, typename Alloc>
+    struct has_ordered_equality<std::basic_string<C, Traits, Alloc>>
+        : std::true_type {
+    };
+
+    template <typename A, typename B>
+    struct has_ordered_equality<std::pair<A, B>>
+        : conjunction<has_ordered_equality<A>, has_ordered_equality<B>> {
+    };
+
+    template <typename... Ts>
+    struct has_ordered_equality<std::tuple<Ts...>>
+        : conjunction<has_ordered_equality<Ts>...> {
+    };
+
+    template <typename T, std::size_t N>
+    struct has_ordered_equality<std::array<T, N>> : has_ordered_equality<T> {
+    };
+
+    template <typename T, typename Alloc>
+    struct has_ordered_equality<std::vector<T, Alloc>> : has_ordered_equality<T> {
+    };
+
+    template <typename T, typename Alloc>
+    struct has_ordered_equality<std::deque<T, Alloc>> : has_ordered_equality<T> {
+    };
+
+    template <typename T, typename Alloc>
+    struct has_ordered_equality<std::list<T, Alloc>> : has_ordered_equality<T> {
+    };
+
+    // Keys are remembered in a hash set if possible,
+    // in an ordered set otherwise.
+    template <typename Key>
+    using seen_keys_t = std::conditional_t<is_hashable<Key>::value,
+        std::unordered_set<Key>,
+        std::set<Key>>;
+
+    template <typename Key>
+    using has_seen_keys = disjunction<is_hashable<Key>, has_ordered_equality<Key>>;
+
+    template <typename Container, typename F>
+    using nub_key_t = std::decay_t<
+        invoke_result_t<F, const typename Container::value_type&>>;
+
+    template <typename Container, typename F>
+    Container nub_on(std::true_type, F f, const Container& xs)
+    {
+        seen_keys_t<nub_key_t<Container, F>> seen;
+        Container result;
+        auto itOut = internal::get_back_inserter(result);
+        for (const auto& x : xs) {
+            if (seen.insert(internal::invoke(f, x)).second) {
+                *itOut = x;
+            }
+        }
+        return result;
+    }
+
+    template <typename Container, typename F>
+    Container nub_on(std::false_type, F f, const Container& xs)
+    {
+        return nub_by(is_equal_by(f), xs);
+    }
+
+    template <typename Container, typename F>
+    bool all_unique_on(std::true_type, F f, const Container& xs)
+    {
+        seen_keys_t<nub_key_t<Container, F>> seen;
+        for (const auto& x : xs) {
+            if (!seen.insert(internal::invoke(f, x)).second) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Container, typename F>
+    bool all_unique_on(std::false_type, F f, const Container& xs)
+    {
+        return all_unique_by_eq(is_equal_by(f), xs);
+    }
+
+    template <typename T>
+    const T& nub_identity(const T& x)
+    {
+        return x;
+    }
+
+} // namespace internal
+
 // API search type: nub_on : ((a -> b), [a]) -> [a]
 // fwd bind count: 1
 // Makes the elements in a container unique
 // with respect to their function value.
 // nub_on((mod 10), [12,32,15]) == [12,15]
-// O(n^2)
+// Function values are only compared using operator==.
+// O(n) if they are hashable, O(n*log(n)) if they are, e.g.,
+// vectors or pairs of integers or strings, O(n^2) otherwise.
 template <typename Container, typename F>
 Container nub_on(F f, const Container& xs)
 {
-    return nub_by(is_equal_by(f), xs);
+    return internal::nub_on(
+        internal::has_seen_keys<internal::nub_key_t<Container, F>>(), f, xs);
 }
 
 // API search type: nub : [a] -> [a]
 // fwd bind count: 0
 // Makes the elements in a container unique.
 // nub([1,2,2,3,2]) == [1,2,3]
-// O(n^2)
+// Elements are only compared using operator==.
+// O(n) if they are hashable, O(n*log(n)) if they are, e.g.,
+// vectors or pairs of integers or strings, O(n^2) otherwise.
 // Also known as distinct.
 template <typename Container>
 Container nub(const Container& xs)
 {
     typedef typename Container::value_type T;
-    return nub_by(std::equal_to<T>(), xs);
-}
-
-// API search type: all_unique_by_eq : (((a, a) -> Bool), [a]) -> Bool
-// fwd bind count: 1
-// Checks if all elements in a container are unique
-// with respect to a predicate.
-// Returns true for empty containers.
-// O(n^2)
-template <typename Container, typename BinaryPredicate>
-bool all_unique_by_eq(BinaryPredicate p, const Container& xs)
-{
-    internal::check_binary_predicate_for_container<BinaryPredicate, Container>();
-    return size_of_cont(nub_by(p, xs)) == size_of_cont(xs);
+    return nub_on(internal::nub_identity<T>, xs);
 }
 
 // API search type: all_unique_on : ((a -> b), [a]) -> Bool
@@ -1764,24 +2132,28 @@ bool all_unique_by_eq(BinaryPredicate p, const Container& xs)
 // Checks if all elements in a container are unique
 // with respect to their function values.
 // Returns true for empty containers.
-// O(n^2)
+// Function values are only compared using operator==.
+// O(n) if they are hashable, O(n*log(n)) if they are, e.g.,
+// vectors or pairs of integers or strings, O(n^2) otherwise.
 template <typename Container, typename F>
 bool all_unique_on(F f, const Container& xs)
 {
-    return all_unique_by_eq(is_equal_by(f), xs);
+    return internal::all_unique_on(
+        internal::has_seen_keys<internal::nub_key_t<Container, F>>(), f, xs);
 }
 
 // API search type: all_unique : [a] -> Bool
 // fwd bind count: 0
 // Checks if all elements in a container are unique.
 // Returns true for empty containers.
-// O(n^2)
+// Elements are only compared using operator==.
+// O(n) if they are hashable, O(n*log(n)) if they are, e.g.,
+// vectors or pairs of integers or strings, O(n^2) otherwise.
 template <typename Container>
 bool all_unique(const Container& xs)
 {
     typedef typename Container::value_type T;
-    auto comp = std::equal_to<T>();
-    return all_unique_by_eq(comp, xs);
+    return all_unique_on(internal::nub_identity<T>, xs);
 }
 
 // API search type: is_strictly_sorted_by : (((a, a) -> Bool), [a]) -> Bool
@@ -2056,32 +2428,239 @@ typename Container::value_type last(const Container& xs)
     return xs.back();
 }
 
+namespace internal {
+
+    // Number of values, mean and sums of powers of the differences
+    // to the mean (m2, m3, m4), updated one value at a time,
+    // which is numerically stable and needs only one pass.
+    // Only the sums up to the power Order are tracked.
+    // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    template <typename Result, int Order>
+    struct moments {
+        Result n = 0;
+        Result mean = 0;
+        Result m2 = 0;
+        Result m3 = 0;
+        Result m4 = 0;
+
+        void add(Result x)
+        {
+            const Result n_before = n;
+            n += 1;
+            const Result delta = x - mean;
+            const Result delta_n = delta / n;
+            const Result term = delta * delta_n * n_before;
+            mean += delta_n;
+            if (Order > 2) {
+                const Result delta_n_sq = delta_n * delta_n;
+                m4 += term * delta_n_sq * (n * n - 3 * n + 3)
+                    + 6 * delta_n_sq * m2 - 4 * delta_n * m3;
+                m3 += term * delta_n * (n - 2) - 3 * delta_n * m2;
+            }
+            m2 += term;
+        }
+
+        void merge(const moments& other)
+        {
+            if (other.n == 0) {
+                return;
+            }
+            if (n == 0) {
+                *this = other;
+                return;
+            }
+            const Result n_a = n;
+            const Result n_b = other.n;
+            const Result n_ab = n_a + n_b;
+            const Result delta = other.mean - mean;
+            const Result delta_sq = delta * delta;
+            if (Order > 2) {
+                m4 += other.m4
+                    + delta_sq * delta_sq * n_a * n_b * (n_a * n_a - n_a * n_b + n_b * n_b)
+                        / (n_ab * n_ab * n_ab)
+                    + 6 * delta_sq * (n_a * n_a * other.m2 + n_b * n_b * m2) / (n_ab * n_ab)
+                    + 4 * delta * (n_a * other.m3 - n_b * m3) / n_ab;
+                m3 += other.m3
+                    + delta * delta_sq * n_a * n_b * (n_a - n_b) / (n_ab * n_ab)
+                    + 3 * delta * (n_a * other.m2 - n_b * m2) / n_ab;
+            }
+            m2 += other.m2 + delta_sq * n_a * n_b / n_ab;
+            mean += delta * n_b / n_ab;
+            n = n_ab;
+        }
+    };
+
+    // Integral result types would truncate the intermediate values.
+    template <typename Result>
+    using moments_value_t = std::conditional_t<
+        std::is_floating_point<Result>::value, Result, double>;
+
+    // The moments of a block small enough to stay in the cache
+    // are calculated by first summing up the values
+    // and then the powers of their differences to the block mean,
+    // in independent lanes, which allows the compiler to vectorize.
+    template <typename Result, int Order, typename T>
+    moments<Result, Order> moments_of_block(const T* xs, std::size_t size)
+    {
+        const auto plus = std::plus<Result>();
+        const Result zero = 0;
+        moments<Result, Order> result;
+        result.n = static_cast<Result>(size);
+        result.mean = reduce_in_lanes(plus, zero, size,
+                          [xs](std::size_t idx) { return static_cast<Result>(xs[idx]); })
+            / result.n;
+        const Result mean = result.mean;
+        result.m2 = reduce_in_lanes(plus, zero, size,
+            [xs, mean](std::size_t idx) {
+                const Result diff = static_cast<Result>(xs[idx]) - mean;
+                return diff * diff;
+            });
+        if (Order > 2) {
+            result.m3 = reduce_in_lanes(plus, zero, size,
+                [xs, mean](std::size_t idx) {
+                    const Result diff = static_cast<Result>(xs[idx]) - mean;
+                    return diff * diff * diff;
+                });
+            result.m4 = reduce_in_lanes(plus, zero, size,
+                [xs, mean](std::size_t idx) {
+                    const Result diff = static_cast<Result>(xs[idx]) - mean;
+                    const Result diff_sq = diff * diff;
+                    return diff_sq * diff_sq;
+                });
+        }
+        return result;
+    }
+
+    template <typename Result, int Order, typename T>
+    moments<Result, Order> moments_of_range(std::true_type,
+        const T* first, const T* last)
+    {
+        const std::size_t block_size = 2048;
+        const std::size_t size = static_cast<std::size_t>(last - first);
+        moments<Result, Order> result;
+        for (std::size_t idx = 0; idx < size; idx += block_size) {
+            result.merge(moments_of_block<Result, Order>(
+                first + idx, std::min(block_size, size - idx)));
+        }
+        return result;
+    }
+
+    template <typename Result, int Order, typename InputIt>
+    moments<Result, Order> moments_of_range(std::false_type,
+        InputIt first, InputIt last)
+    {
+        moments<Result, Order> result;
+        for (; first != last; ++first) {
+            result.add(static_cast<Result>(*first));
+        }
+        return result;
+    }
+
+    // Contiguous arithmetic values are processed block by block.
+    template <typename Result, int Order, typename InputIt>
+    moments<Result, Order> moments_of_range(InputIt first, InputIt last)
+    {
+        return moments_of_range<Result, Order>(
+            std::integral_constant<bool,
+                std::is_pointer<InputIt>::value
+                    && std::is_arithmetic<std::remove_pointer_t<InputIt>>::value>(),
+            first, last);
+    }
+
+    template <typename Container, typename = void>
+    struct has_contiguous_data : std::false_type {
+    };
+
+    template <typename Container>
+    struct has_contiguous_data<Container,
+        void_t<decltype(std::declval<const Container&>().data())>>
+        : std::is_same<decltype(std::declval<const Container&>().data()),
+              const typename Container::value_type*> {
+    };
+
+    template <typename Result, int Order, typename Container>
+    moments<Result, Order> moments_of(std::true_type, const Container& xs)
+    {
+        return moments_of_range<Result, Order>(xs.data(), xs.data() + xs.size());
+    }
+
+    template <typename Result, int Order, typename Container>
+    moments<Result, Order> moments_of(std::false_type, const Container& xs)
+    {
+        return moments_of_range<Result, Order>(std::begin(xs), std::end(xs));
+    }
+
+    template <typename Result, int Order, typename Container>
+    moments<Result, Order> moments_of(const Container& xs)
+    {
+        return moments_of<Result, Order>(has_contiguous_data<Container>(), xs);
+    }
+
+    template <typename Result, int Order>
+    std::pair<Result, Result> mean_stddev_of(const moments<moments_value_t<Result>, Order>& m)
+    {
+        return std::make_pair(static_cast<Result>(m.mean),
+            static_cast<Result>(std::sqrt(m.m2 / m.n)));
+    }
+
+} // namespace internal
+
 // API search type: mean_stddev : [a] -> (a, a)
 // fwd bind count: 0
 // Calculates the mean and the population standard deviation.
 // mean_stddev([4, 8]) == (6, 2)
-// mean_stddev([1, 3, 7, 4]) == (3.75, 2.5)
+// mean_stddev([1, 3, 7, 4]) == (3.75, 2.165)
+// Needs only one pass over xs and no additional memory.
 // xs must be non-empty.
 template <typename Result, typename Container>
 std::pair<Result, Result> mean_stddev(const Container& xs)
 {
     assert(size_of_cont(xs) != 0);
+    return internal::mean_stddev_of<Result>(
+        internal::moments_of<internal::moments_value_t<Result>, 2>(xs));
+}
+
+// API search type: variance : [a] -> a
+// fwd bind count: 0
+// Calculates the population variance.
+// variance([4, 8]) == 4
+// xs must be non-empty.
+template <typename Result, typename Container>
+Result variance(const Container& xs)
+{
+    assert(size_of_cont(xs) != 0);
+    const auto m = internal::moments_of<internal::moments_value_t<Result>, 2>(xs);
+    return static_cast<Result>(m.m2 / m.n);
+}
 
-    // http://stackoverflow.com/a/7616783/1866775
-    Result sum = static_cast<Result>(
-        internal::accumulate(xs.begin(), xs.end(),
-            static_cast<typename Container::value_type>(0)));
-    Result mean = sum / static_cast<Result>(xs.size());
-
-    std::vector<Result> diff(xs.size());
-    std::transform(xs.begin(), xs.end(), diff.begin(),
-        [mean](Result x) {
-            return x - mean;
-        });
-    Result sq_sum = std::inner_product(
-        diff.begin(), diff.end(), diff.begin(), static_cast<Result>(0));
-    Result stddev = std::sqrt(sq_sum / static_cast<Result>(xs.size()));
-    return std::make_pair(mean, stddev);
+// API search type: skewness : [a] -> a
+// fwd bind count: 0
+// Calculates the population skewness,
+// i.e., the third standardized moment.
+// skewness([1, 2, 3]) == 0
+// skewness([1, 2, 6]) == 0.595
+// xs must be non-empty and contain different values.
+template <typename Result, typename Container>
+Result skewness(const Container& xs)
+{
+    assert(size_of_cont(xs) != 0);
+    const auto m = internal::moments_of<internal::moments_value_t<Result>, 4>(xs);
+    return static_cast<Result>(std::sqrt(m.n) * m.m3 / std::pow(m.m2, 1.5));
+}
+
+// API search type: kurtosis : [a] -> a
+// fwd bind count: 0
+// Calculates the population kurtosis,
+// i.e., the fourth standardized moment.
+// Subtract 3 to get the excess kurtosis.
+// kurtosis([1, 2, 3, 4]) == 1.64
+// xs must be non-empty and contain different values.
+template <typename Result, typename Container>
+Result kurtosis(const Container& xs)
+{
+    assert(size_of_cont(xs) != 0);
+    const auto m = internal::moments_of<internal::moments_value_t<Result>, 4>(xs);
+    return static_cast<Result>(m.n * m.m4 / (m.m2 * m.m2));
 }
 
 // API search type: count_occurrences_by : ((a -> b), [a]) -> Map b Int
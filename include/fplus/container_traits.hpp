@@ -9,21 +9,28 @@
 #include <array>
 #include <deque>
 #include <forward_list>
+#include <functional>
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stack>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <fplus/internal/invoke.hpp>
+#include <fplus/small_vector.hpp>
 
 namespace fplus {
 
+template <typename T>
+class span_view;
+
 namespace internal {
 
 #ifdef __GNUC__
@@ -64,6 +71,37 @@ namespace internal {
     template <class CharT, class Traits, class Alloc>
     struct has_order<std::basic_string<CharT, Traits, Alloc>> : public std::true_type {
     };
+    template <class T>
+    struct has_order<span_view<T>> : public std::true_type {
+    };
+    template <class T, std::size_t N>
+    struct has_order<small_vector<T, N>> : public std::true_type {
+    };
+
+    // Custom allocators are kept, e.g. std::pmr::vector<int>
+    // becomes std::pmr::vector<std::string>.
+    template <class Alloc, class NewT>
+    using rebind_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<NewT>;
+
+    // Function objects like comparators are kept, too.
+    // Class templates instantiated for the old element type,
+    // e.g. std::greater<T>, are instantiated for the new one.
+    // Others are only kept if the element type does not change.
+    template <class F, class T, class NewT, class Fallback>
+    struct rebind_functor {
+        typedef std::conditional_t<std::is_same<T, NewT>::value, F, Fallback> type;
+    };
+    template <template <class> class F, class T, class NewT, class Fallback>
+    struct rebind_functor<F<T>, T, NewT, Fallback> {
+        typedef F<NewT> type;
+    };
+    // Transparent function objects, e.g. std::less<>, work for all types.
+    template <template <class> class F, class T, class NewT, class Fallback>
+    struct rebind_functor<F<void>, T, NewT, Fallback> {
+        typedef F<void> type;
+    };
+    template <class F, class T, class NewT, class Fallback>
+    using rebind_functor_t = typename rebind_functor<F, T, NewT, Fallback>::type;
 
     // http://stackoverflow.com/a/33828321/1866775
     template <class Cont, class NewT, int SizeOffset = std::numeric_limits<int>::lowest()>
@@ -74,25 +112,28 @@ namespace internal {
         static_assert(SizeOffset != std::numeric_limits<int>::lowest(), "Size of std::array must be known at compile-time.");
         typedef typename std::array<NewT, static_cast<std::size_t>(static_cast<int>(N) + SizeOffset)> type;
     };
-    template <class T, template <class> class Alloc, class NewT, int SizeOffset>
-    struct same_cont_new_t<std::vector<T, Alloc<T>>, NewT, SizeOffset> {
-        typedef typename std::vector<NewT, Alloc<NewT>> type;
+    template <class T, class Alloc, class NewT, int SizeOffset>
+    struct same_cont_new_t<std::vector<T, Alloc>, NewT, SizeOffset> {
+        typedef typename std::vector<NewT, rebind_alloc_t<Alloc, NewT>> type;
     };
-    template <class T, template <class> class Alloc, class NewT, int SizeOffset>
-    struct same_cont_new_t<std::deque<T, Alloc<T>>, NewT, SizeOffset> {
-        typedef typename std::deque<NewT, Alloc<NewT>> type;
+    template <class T, class Alloc, class NewT, int SizeOffset>
+    struct same_cont_new_t<std::deque<T, Alloc>, NewT, SizeOffset> {
+        typedef typename std::deque<NewT, rebind_alloc_t<Alloc, NewT>> type;
     };
-    template <class T, template <class> class Alloc, class NewT, int SizeOffset>
-    struct same_cont_new_t<std::forward_list<T, Alloc<T>>, NewT, SizeOffset> {
-        typedef typename std::forward_list<NewT, Alloc<NewT>> type;
+    template <class T, class Alloc, class NewT, int SizeOffset>
+    struct same_cont_new_t<std::forward_list<T, Alloc>, NewT, SizeOffset> {
+        typedef typename std::forward_list<NewT, rebind_alloc_t<Alloc, NewT>> type;
     };
-    template <class T, template <class> class Alloc, class NewT, int SizeOffset>
-    struct same_cont_new_t<std::list<T, Alloc<T>>, NewT, SizeOffset> {
-        typedef typename std::list<NewT, Alloc<NewT>> type;
+    template <class T, class Alloc, class NewT, int SizeOffset>
+    struct same_cont_new_t<std::list<T, Alloc>, NewT, SizeOffset> {
+        typedef typename std::list<NewT, rebind_alloc_t<Alloc, NewT>> type;
     };
-    template <class T, template <class> class Alloc, class NewT, int SizeOffset>
-    struct same_cont_new_t<std::set<T, Alloc<T>>, NewT, SizeOffset> {
-        typedef typename std::set<NewT, Alloc<NewT>> type;
+    template <class T, class Compare, class Alloc, class NewT, int SizeOffset>
+    struct same_cont_new_t<std::set<T, Compare, Alloc>, NewT, SizeOffset> {
+        typedef typename std::set<NewT,
+            rebind_functor_t<Compare, T, NewT, std::less<NewT>>,
+            rebind_alloc_t<Alloc, NewT>>
+            type;
     };
     template <class T, class Container, class NewT, int SizeOffset>
     struct same_cont_new_t<std::stack<T, Container>, NewT, SizeOffset> {
@@ -108,7 +149,17 @@ namespace internal {
     };
     template <class CharT, class Traits, class Alloc, class NewT, int SizeOffset>
     struct same_cont_new_t<std::basic_string<CharT, Traits, Alloc>, NewT, SizeOffset> {
-        typedef typename std::basic_string<NewT, Traits, Alloc> type;
+        typedef typename std::basic_string<NewT, Traits, rebind_alloc_t<Alloc, NewT>> type;
+    };
+    // Views do not own their elements, so new ones are stored in a vector.
+    template <class T, class NewT, int SizeOffset>
+    struct same_cont_new_t<span_view<T>, NewT, SizeOffset> {
+        typedef typename std::vector<NewT> type;
+    };
+
+    template <class T, std::size_t N, class NewT, int SizeOffset>
+    struct same_cont_new_t<small_vector<T, N>, NewT, SizeOffset> {
+        typedef typename fplus::small_vector<NewT, N> type;
     };
 
     // For aligned allocators.
@@ -126,11 +177,18 @@ namespace internal {
     };
     template <class Key, class T, class Compare, class Alloc, class NewKey, class NewVal>
     struct SameMapTypeNewTypes<std::map<Key, T, Compare, Alloc>, NewKey, NewVal> {
-        typedef typename std::map<NewKey, NewVal> type;
-    };
-    template <class Key, class T, class Compare, class Alloc, class NewKey, class NewVal>
-    struct SameMapTypeNewTypes<std::unordered_map<Key, T, Compare, Alloc>, NewKey, NewVal> {
-        typedef typename std::unordered_map<NewKey, NewVal> type;
+        typedef typename std::map<NewKey, NewVal,
+            rebind_functor_t<Compare, Key, NewKey, std::less<NewKey>>,
+            rebind_alloc_t<Alloc, std::pair<const NewKey, NewVal>>>
+            type;
+    };
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc, class NewKey, class NewVal>
+    struct SameMapTypeNewTypes<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>, NewKey, NewVal> {
+        typedef typename std::unordered_map<NewKey, NewVal,
+            rebind_functor_t<Hash, Key, NewKey, std::hash<NewKey>>,
+            rebind_functor_t<KeyEqual, Key, NewKey, std::equal_to<NewKey>>,
+            rebind_alloc_t<Alloc, std::pair<const NewKey, NewVal>>>
+            type;
     };
 
 #ifdef __GNUC__
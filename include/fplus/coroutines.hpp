@@ -0,0 +1,492 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+// Everything in here requires C++20 coroutine support
+// and is left out silently otherwise.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <fplus/async.hpp>
+#include <fplus/container_common.hpp>
+#include <fplus/generate.hpp>
+#include <fplus/internal/invoke.hpp>
+#include <fplus/maybe.hpp>
+
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fplus {
+
+// A lazily evaluated, single-pass sequence produced by a coroutine
+// using co_yield. Values are computed on demand while iterating,
+// so even infinite or huge sequences need constant memory.
+//
+// Example usage:
+//
+// generator<int> squares()
+// {
+//     for (int i = 0;; ++i)
+//         co_yield i * i;
+// }
+// for (int x : squares()) { if (x > 100) break; ... }
+template <typename T>
+class generator {
+public:
+    typedef T value_type;
+
+    struct promise_type {
+        const T* current_ = nullptr;
+        std::exception_ptr exception_ = nullptr;
+
+        generator get_return_object()
+        {
+            return generator(handle_t::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& value) noexcept
+        {
+            current_ = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept { }
+        void unhandled_exception() { exception_ = std::current_exception(); }
+        // A generator only produces values, it does not wait for anything.
+        template <typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        iterator()
+            : handle_(nullptr)
+        {
+        }
+        explicit iterator(handle_t handle)
+            : handle_(handle)
+        {
+        }
+        iterator& operator++()
+        {
+            handle_.resume();
+            finish_if_done();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        const T& operator*() const { return *handle_.promise().current_; }
+        const T* operator->() const { return handle_.promise().current_; }
+        bool operator==(const iterator& other) const { return handle_ == other.handle_; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class generator;
+        void finish_if_done()
+        {
+            if (handle_.done()) {
+                const auto exception = handle_.promise().exception_;
+                handle_ = nullptr;
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+        handle_t handle_;
+    };
+
+    generator(generator&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+    generator& operator=(generator&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    generator(const generator&) = delete;
+    generator& operator=(const generator&) = delete;
+    ~generator() { destroy(); }
+
+    // Starts the computation, so it must only be called once.
+    iterator begin()
+    {
+        iterator it(handle_);
+        if (handle_) {
+            ++it;
+        }
+        return it;
+    }
+    iterator end() { return iterator(); }
+
+private:
+    friend struct promise_type;
+    explicit generator(handle_t handle)
+        : handle_(handle)
+    {
+    }
+    void destroy()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+    handle_t handle_;
+};
+
+// API search type: iterate_lazily : ((a -> a), a) -> Generator a
+// Lazy and infinite version of iterate.
+// iterate_lazily((*2), 3) == [3, 6, 12, 24, 48, ...]
+template <typename F, typename T>
+generator<T> iterate_lazily(F f, T x)
+{
+    for (;;) {
+        co_yield x;
+        x = internal::invoke(f, x);
+    }
+}
+
+// API search type: take_lazily : (Int, Generator a) -> Generator a
+// Stops a (possibly infinite) generator after n values.
+// take_lazily(3, iterate_lazily((*2), 3)) == [3, 6, 12]
+template <typename T>
+generator<T> take_lazily(std::size_t n, generator<T> xs)
+{
+    if (n == 0) {
+        co_return;
+    }
+    std::size_t i = 0;
+    for (const T& x : xs) {
+        co_yield x;
+        if (++i == n) {
+            co_return;
+        }
+    }
+}
+
+// API search type: numbers_lazily : (a, a) -> Generator a
+// Lazy version of numbers.
+// numbers_lazily(2, 9) == [2, 3, 4, 5, 6, 7, 8]
+template <typename T>
+generator<T> numbers_lazily(T start, T end)
+{
+    for (T x = start; x < end; ++x) {
+        co_yield x;
+    }
+}
+
+// API search type: infixes_lazily : (Int, [a]) -> Generator [a]
+// Lazy version of infixes.
+// infixes_lazily(3, [1,2,3,4,5,6]) == [[1,2,3], [2,3,4], [3,4,5], [4,5,6]]
+// length must be > 0
+template <typename ContainerIn>
+generator<ContainerIn> infixes_lazily(std::size_t length, ContainerIn xs)
+{
+    assert(length > 0);
+    if (size_of_cont(xs) < length) {
+        co_return;
+    }
+    for (std::size_t idx = 0; idx <= size_of_cont(xs) - length; ++idx) {
+        co_yield get_segment(idx, idx + length, xs);
+    }
+}
+
+// API search type: carthesian_product_lazily : ([a], [b]) -> Generator (a, b)
+// Lazy version of carthesian_product.
+// carthesian_product_lazily("ABC", "XY")
+//   == [(A,X),(A,Y),(B,X),(B,Y),(C,X),(C,Y)]
+template <typename Container1, typename Container2,
+    typename T = std::pair<typename Container1::value_type,
+        typename Container2::value_type>>
+generator<T> carthesian_product_lazily(Container1 xs, Container2 ys)
+{
+    for (const auto& x : xs) {
+        for (const auto& y : ys) {
+            co_yield T(x, y);
+        }
+    }
+}
+
+// API search type: permutations_lazily : (Int, [a]) -> Generator [a]
+// Lazy version of permutations,
+// producing the same sequences in the same order.
+// permutations_lazily(2, "ABCD") == AB AC AD BA BC BD CA CB CD DA DB DC
+template <typename ContainerIn>
+generator<ContainerIn> permutations_lazily(std::size_t power, ContainerIn xs_in)
+{
+    using T = typename ContainerIn::value_type;
+    const std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
+    for (permutation_state state(xs.size(), power); state.is_valid(); state.next()) {
+        co_yield convert_container<ContainerIn>(elems_at_idxs(state.idxs(), xs));
+    }
+}
+
+// API search type: combinations_lazily : (Int, [a]) -> Generator [a]
+// Lazy version of combinations,
+// producing the same sequences in the same order.
+// combinations_lazily(2, "ABCD") == AB AC AD BC BD CD
+template <typename ContainerIn>
+generator<ContainerIn> combinations_lazily(std::size_t power, ContainerIn xs_in)
+{
+    using T = typename ContainerIn::value_type;
+    const std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
+    for (combination_state state(xs.size(), power); state.is_valid(); state.next()) {
+        co_yield convert_container<ContainerIn>(elems_at_idxs(state.idxs(), xs));
+    }
+}
+
+// API search type: power_set_lazily : [a] -> Generator [a]
+// Lazy version of power_set,
+// producing the same sequences in the same order.
+// power_set_lazily("xyz") == ["", "x", "y", "z", "xy", "xz", "yz", "xyz"]
+template <typename ContainerIn>
+generator<ContainerIn> power_set_lazily(ContainerIn xs)
+{
+    for (std::size_t power = 0; power <= size_of_cont(xs); ++power) {
+        for (const auto& ys : combinations_lazily(power, xs)) {
+            co_yield ys;
+        }
+    }
+}
+
+template <typename T>
+class task;
+
+namespace internal {
+
+    // A coroutine that starts immediately and cleans up after itself.
+    struct detached_coroutine {
+        struct promise_type {
+            detached_coroutine get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept { }
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+    // Resumes the coroutine waiting for a task when the task is finished.
+    struct task_final_awaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<Promise> handle) noexcept
+        {
+            const auto continuation = handle.promise().continuation_;
+            if (continuation) {
+                return continuation;
+            }
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept { }
+    };
+
+    // Runs an effect on the default thread pool
+    // and resumes the awaiting coroutine there afterwards.
+    template <typename Effect>
+    class effect_awaiter {
+    public:
+        using T = internal::invoke_non_void_result_t<Effect>;
+        explicit effect_awaiter(Effect eff)
+            : eff_(std::move(eff))
+            , result_()
+            , exception_()
+        {
+        }
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            default_thread_pool().post([this, handle]() {
+                try {
+                    result_ = maybe<T>(internal::invoke_non_void(eff_));
+                } catch (...) {
+                    exception_ = std::current_exception();
+                }
+                handle.resume();
+            });
+        }
+        T await_resume()
+        {
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+            return std::move(result_.unsafe_get_just());
+        }
+
+    private:
+        Effect eff_;
+        maybe<T> result_;
+        std::exception_ptr exception_;
+    };
+
+} // namespace internal
+
+// A lazily started coroutine producing one value of type T (via co_return).
+// It runs when it is co_awaited by another coroutine
+// or when get() is called, which blocks until the value is available.
+// Side effects can be awaited inside with co_await execute_effect_async(eff),
+// which runs them on the default thread pool.
+//
+// Example usage:
+//
+// task<std::size_t> count_lines(std::string filename)
+// {
+//     const auto lines = co_await execute_effect_async(
+//         read_text_file_lines(true, filename));
+//     co_return lines.size();
+// }
+// count_lines("foo.txt").get();
+template <typename T>
+class task {
+public:
+    typedef T value_type;
+
+    struct promise_type {
+        maybe<T> value_ = maybe<T>();
+        std::exception_ptr exception_ = nullptr;
+        std::coroutine_handle<> continuation_ = nullptr;
+
+        task get_return_object()
+        {
+            return task(handle_t::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        internal::task_final_awaiter final_suspend() noexcept { return {}; }
+        template <typename U>
+        void return_value(U&& value)
+        {
+            value_ = maybe<T>(T(std::forward<U>(value)));
+        }
+        void unhandled_exception() { exception_ = std::current_exception(); }
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    task(task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    ~task() { destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+    {
+        return start_awaiter { handle_ }.await_suspend(awaiting);
+    }
+    T await_resume() { return take_result(); }
+
+    // Runs the task and blocks the calling thread until it is finished.
+    // Rethrows the exception if the task failed.
+    T get()
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool done = false;
+        const auto wait_for_task = [](handle_t handle, std::mutex& m,
+                                       std::condition_variable& c, bool& d)
+            -> internal::detached_coroutine {
+            co_await start_awaiter { handle };
+            std::lock_guard<std::mutex> lock(m);
+            d = true;
+            c.notify_all();
+        };
+        wait_for_task(handle_, mutex, cond, done);
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&done]() { return done; });
+        return take_result();
+    }
+
+private:
+    // Starts the task and resumes the awaiting coroutine once it is finished.
+    struct start_awaiter {
+        handle_t handle_;
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+        {
+            handle_.promise().continuation_ = awaiting;
+            return handle_;
+        }
+        void await_resume() const noexcept { }
+    };
+    friend struct promise_type;
+    explicit task(handle_t handle)
+        : handle_(handle)
+    {
+    }
+    T take_result()
+    {
+        auto& promise = handle_.promise();
+        if (promise.exception_) {
+            std::rethrow_exception(promise.exception_);
+        }
+        return std::move(promise.value_.unsafe_get_just());
+    }
+    void destroy()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+    handle_t handle_;
+};
+
+// API search type: execute_effect_async : Io a -> Awaitable a
+// Returns an awaitable that, when co_awaited inside a task,
+// runs the given side effect on the default thread pool
+// and resumes the task with its result.
+// Effects returning void result in true.
+template <typename Effect>
+internal::effect_awaiter<Effect> execute_effect_async(Effect eff)
+{
+    return internal::effect_awaiter<Effect>(std::move(eff));
+}
+
+// API search type: execute_as_task : Io a -> Task a
+// Wraps a side effect into a task running it on the default thread pool.
+// Effects returning void result in true.
+template <typename Effect>
+task<internal::invoke_non_void_result_t<Effect>> execute_as_task(Effect eff)
+{
+    co_return co_await execute_effect_async(std::move(eff));
+}
+
+} // namespace fplus
+
+#endif
@@ -31,7 +31,7 @@ namespace internal {
         const Container& xs)
     {
         internal::check_unary_predicate_for_container<Pred, Container>();
-        Container result;
+        auto result = internal::new_container_like<Container>(xs);
         auto it = internal::get_back_inserter(result);
         std::copy_if(std::begin(xs), std::end(xs), it, pred);
         return result;
@@ -64,6 +64,34 @@ ContainerOut drop_if(Pred pred, Container&& xs)
     return keep_if(logical_not(pred), std::forward<Container>(xs));
 }
 
+// API search type: keep_if_into : ((a -> Bool), [a], [a]) -> ()
+// Same as keep_if, but writes the kept elements into ys
+// (a container or an output iterator), like transform_into does.
+template <typename Pred, typename Container, typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt keep_if_into(Pred pred, const Container& xs, OutputIt it)
+{
+    internal::check_unary_predicate_for_container<Pred, Container>();
+    return std::copy_if(std::begin(xs), std::end(xs), it, pred);
+}
+
+template <typename Pred, typename Container, typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void keep_if_into(Pred pred, const Container& xs, ContainerOut& ys)
+{
+    ys.clear();
+    keep_if_into(pred, xs, internal::get_back_inserter(ys));
+}
+
+// API search type: drop_if_into : ((a -> Bool), [a], [a]) -> ()
+// Same as drop_if, but writes the remaining elements into ys
+// (a container or an output iterator), like transform_into does.
+template <typename Pred, typename Container, typename ContainerOut>
+auto drop_if_into(Pred pred, const Container& xs, ContainerOut&& ys)
+{
+    return keep_if_into(logical_not(pred), xs, std::forward<ContainerOut>(ys));
+}
+
 // API search type: without : (a, [a]) -> [a]
 // fwd bind count: 1
 // Keep all elements a sequence not equal to elem.
@@ -101,7 +129,7 @@ template <typename Pred, typename Container>
 Container keep_if_with_idx(Pred pred, const Container& xs)
 {
     internal::check_index_with_type_predicate_for_container<Pred, Container>();
-    Container ys;
+    auto ys = internal::new_container_like<Container>(xs);
     auto it = internal::get_back_inserter(ys);
     std::size_t idx = 0;
     for (const auto& x : xs) {
@@ -146,7 +174,7 @@ namespace internal {
     Container keep_by_idx(internal::create_new_container_t,
         UnaryPredicate pred, const Container& xs)
     {
-        Container ys = xs;
+        Container ys = internal::copy_container(xs);
         return internal::keep_by_idx(internal::reuse_container_t(),
             pred, std::move(ys));
     }
@@ -6,17 +6,23 @@
 
 #pragma once
 
+#include <fplus/aligned_allocator.hpp>
+#include <fplus/async.hpp>
 #include <fplus/benchmark_session.hpp>
+#include <fplus/cancellation_token.hpp>
 #include <fplus/compare.hpp>
 #include <fplus/composition.hpp>
 #include <fplus/container_common.hpp>
 #include <fplus/container_properties.hpp>
 #include <fplus/container_traits.hpp>
+#include <fplus/coroutines.hpp>
 #include <fplus/extrapolate.hpp>
 #include <fplus/filter.hpp>
 #include <fplus/generate.hpp>
 #include <fplus/interpolate.hpp>
+#include <fplus/mapped_file.hpp>
 #include <fplus/maps.hpp>
+#include <fplus/matrix.hpp>
 #include <fplus/maybe.hpp>
 #include <fplus/numeric.hpp>
 #include <fplus/optimize.hpp>
@@ -31,6 +37,8 @@
 #include <fplus/shared_ref.hpp>
 #include <fplus/show.hpp>
 #include <fplus/side_effects.hpp>
+#include <fplus/small_vector.hpp>
+#include <fplus/span_view.hpp>
 #include <fplus/split.hpp>
 #include <fplus/stopwatch.hpp>
 #include <fplus/string_tools.hpp>
@@ -11,6 +11,9 @@
 
 #include <fplus/internal/asserts/functions.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace fplus {
 
 // API search type: generate : ((() -> a), Int) -> [a]
@@ -199,8 +202,288 @@ namespace internal {
         };
         return fold_right(go, VecVec(1), replicate(power, xs));
     }
+
+    // Advances idxs (k distinct indices smaller than n)
+    // to the next k-permutation in lexicographic order.
+    // used must flag exactly the indices contained in idxs.
+    // Returns false if idxs already was the last permutation.
+    inline bool next_k_permutation_idxs(std::size_t n,
+        std::vector<std::size_t>& idxs, std::vector<bool>& used)
+    {
+        const std::size_t k = idxs.size();
+        for (std::size_t i = k; i-- > 0;) {
+            used[idxs[i]] = false;
+            for (std::size_t v = idxs[i] + 1; v < n; ++v) {
+                if (!used[v]) {
+                    idxs[i] = v;
+                    used[v] = true;
+                    std::size_t next_free = 0;
+                    for (std::size_t j = i + 1; j < k; ++j) {
+                        while (used[next_free]) {
+                            ++next_free;
+                        }
+                        idxs[j] = next_free;
+                        used[next_free] = true;
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Advances idxs (k strictly increasing indices smaller than n)
+    // to the next k-combination in lexicographic order.
+    // Returns false if idxs already was the last combination.
+    inline bool next_k_combination_idxs(std::size_t n,
+        std::vector<std::size_t>& idxs)
+    {
+        const std::size_t k = idxs.size();
+        for (std::size_t i = k; i-- > 0;) {
+            if (idxs[i] < n - k + i) {
+                ++idxs[i];
+                for (std::size_t j = i + 1; j < k; ++j) {
+                    idxs[j] = idxs[j - 1] + 1;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Advances idxs (k non-decreasing indices smaller than n)
+    // to the next k-combination with replacement in lexicographic order.
+    // Returns false if idxs already was the last combination.
+    inline bool next_k_combination_with_replacement_idxs(std::size_t n,
+        std::vector<std::size_t>& idxs)
+    {
+        const std::size_t k = idxs.size();
+        for (std::size_t i = k; i-- > 0;) {
+            if (idxs[i] + 1 < n) {
+                ++idxs[i];
+                for (std::size_t j = i + 1; j < k; ++j) {
+                    idxs[j] = idxs[i];
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Number of k-permutations of n elements, i.e., n! / (n-k)!
+    // Saturates at the maximum value of std::size_t.
+    inline std::size_t count_k_permutations(std::size_t n, std::size_t k)
+    {
+        if (k > n) {
+            return 0;
+        }
+        const std::size_t max = std::numeric_limits<std::size_t>::max();
+        std::size_t result = 1;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (result > max / (n - i)) {
+                return max;
+            }
+            result *= n - i;
+        }
+        return result;
+    }
+
+    inline std::size_t greatest_common_divisor(std::size_t a, std::size_t b)
+    {
+        while (b != 0) {
+            const std::size_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    // Number of k-combinations of n elements, i.e., n! / (k! * (n-k)!)
+    // Saturates at the maximum value of std::size_t.
+    inline std::size_t count_k_combinations(std::size_t n, std::size_t k)
+    {
+        if (k > n) {
+            return 0;
+        }
+        k = std::min(k, n - k);
+        const std::size_t max = std::numeric_limits<std::size_t>::max();
+        std::size_t result = 1;
+        for (std::size_t i = 0; i < k; ++i) {
+            // result * (n - i) is divisible by (i + 1),
+            // so dividing first by their common factors is exact
+            // and only overflows if the binomial coefficient C(n, i + 1),
+            // and thus C(n, k), does not fit.
+            const std::size_t divisor = i + 1;
+            const std::size_t g = greatest_common_divisor(result, divisor);
+            const std::size_t factor = (n - i) / (divisor / g);
+            result /= g;
+            if (result > max / factor) {
+                return max;
+            }
+            result *= factor;
+        }
+        return result;
+    }
+
+    // The k-permutation of the indices smaller than n
+    // at position rank in lexicographic order.
+    inline std::vector<std::size_t> nth_k_permutation_idxs(
+        std::size_t n, std::size_t k, std::size_t rank)
+    {
+        assert(k <= n && (rank == 0 || rank < count_k_permutations(n, k)));
+        std::vector<std::size_t> idxs;
+        idxs.reserve(k);
+        std::vector<bool> used(n, false);
+        for (std::size_t i = 0; i < k; ++i) {
+            const std::size_t block = count_k_permutations(n - i - 1, k - i - 1);
+            std::size_t skip = rank / block;
+            rank %= block;
+            std::size_t v = 0;
+            for (;; ++v) {
+                if (!used[v]) {
+                    if (skip == 0) {
+                        break;
+                    }
+                    --skip;
+                }
+            }
+            used[v] = true;
+            idxs.push_back(v);
+        }
+        return idxs;
+    }
+
+    // The k-combination of the indices smaller than n
+    // at position rank in lexicographic order.
+    inline std::vector<std::size_t> nth_k_combination_idxs(
+        std::size_t n, std::size_t k, std::size_t rank)
+    {
+        assert(k <= n && (rank == 0 || rank < count_k_combinations(n, k)));
+        std::vector<std::size_t> idxs;
+        idxs.reserve(k);
+        std::size_t v = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            for (;; ++v) {
+                const std::size_t block = count_k_combinations(n - v - 1, k - i - 1);
+                if (rank < block) {
+                    break;
+                }
+                rank -= block;
+            }
+            idxs.push_back(v);
+            ++v;
+        }
+        return idxs;
+    }
 }
 
+// Steps through the k-permutations of the indices [0, n)
+// in lexicographic order, one at a time,
+// i.e., without materializing all of them.
+// permutation_state(3, 2) visits [0,1] [0,2] [1,0] [1,2] [2,0] [2,1]
+// It can also start at the permutation with a given rank
+// (see nth_permutation), so the whole range can be split
+// into independent parts, e.g., for processing them in parallel.
+class permutation_state {
+public:
+    permutation_state(std::size_t n, std::size_t k, std::size_t rank = 0)
+        : n_(n)
+        , idxs_()
+        , used_(n, false)
+        , valid_(k <= n && (rank == 0 || rank < internal::count_k_permutations(n, k)))
+    {
+        if (valid_) {
+            idxs_ = internal::nth_k_permutation_idxs(n, k, rank);
+            for (const std::size_t idx : idxs_) {
+                used_[idx] = true;
+            }
+        }
+    }
+    // False if there were no (more) permutations.
+    bool is_valid() const { return valid_; }
+    // The current permutation. Only to be called if is_valid().
+    const std::vector<std::size_t>& idxs() const
+    {
+        assert(valid_);
+        return idxs_;
+    }
+    // Advances to the next permutation and returns is_valid().
+    bool next()
+    {
+        valid_ = valid_ && internal::next_k_permutation_idxs(n_, idxs_, used_);
+        return valid_;
+    }
+
+private:
+    std::size_t n_;
+    std::vector<std::size_t> idxs_;
+    std::vector<bool> used_;
+    bool valid_;
+};
+
+// Steps through the k-combinations of the indices [0, n)
+// in lexicographic order, one at a time,
+// i.e., without materializing all of them.
+// combination_state(4, 2) visits [0,1] [0,2] [0,3] [1,2] [1,3] [2,3]
+// It can also start at the combination with a given rank
+// (see nth_combination).
+class combination_state {
+public:
+    combination_state(std::size_t n, std::size_t k, std::size_t rank = 0)
+        : n_(n)
+        , idxs_()
+        , valid_(k <= n && (rank == 0 || rank < internal::count_k_combinations(n, k)))
+    {
+        if (valid_) {
+            idxs_ = internal::nth_k_combination_idxs(n, k, rank);
+        }
+    }
+    // False if there were no (more) combinations.
+    bool is_valid() const { return valid_; }
+    // The current combination. Only to be called if is_valid().
+    const std::vector<std::size_t>& idxs() const
+    {
+        assert(valid_);
+        return idxs_;
+    }
+    // Advances to the next combination and returns is_valid().
+    bool next()
+    {
+        valid_ = valid_ && internal::next_k_combination_idxs(n_, idxs_);
+        return valid_;
+    }
+
+private:
+    std::size_t n_;
+    std::vector<std::size_t> idxs_;
+    bool valid_;
+};
+
+namespace internal {
+
+    // Calls f with the elements of xs selected by every idxs
+    // the state steps through, reusing one buffer.
+    // Stops early if f returns false.
+    template <typename T, typename F, typename State, typename Next>
+    bool for_each_selection(F f, const std::vector<T>& xs,
+        State& idxs, Next next)
+    {
+        std::vector<T> selection;
+        selection.reserve(idxs.size());
+        do {
+            selection.clear();
+            for (const std::size_t idx : idxs) {
+                selection.push_back(xs[idx]);
+            }
+            if (!internal::invoke(f, static_cast<const std::vector<T>&>(selection))) {
+                return false;
+            }
+        } while (next(idxs));
+        return true;
+    }
+
+} // namespace internal
+
 // API search type: carthesian_product_n : (Int, [a]) -> [[a]]
 // fwd bind count: 1
 // Returns the product set with a given power.
@@ -224,10 +507,124 @@ ContainerOut carthesian_product_n(std::size_t power, const ContainerIn& xs_in)
     return transform(to_result_cont, result_idxss);
 }
 
+// API search type: for_each_permutation : (Int, ([a] -> Bool), [a]) -> Bool
+// fwd bind count: 2
+// Calls f with every permutation of the given power in the same order
+// as permutations does, but without creating all of them up front.
+// The same buffer is reused for every call,
+// so f must copy the permutation if it wants to keep it.
+// Stops as soon as f returns false.
+// Returns true if all permutations were visited.
+// for_each_permutation(2, f, "ABC") calls f with AB AC BA BC CA CB
+template <typename F, typename ContainerIn>
+bool for_each_permutation(std::size_t power, F f, const ContainerIn& xs_in)
+{
+    using T = typename ContainerIn::value_type;
+    const std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
+    if (power > xs.size()) {
+        return true;
+    }
+    std::vector<std::size_t> idxs = numbers<std::size_t>(0, power);
+    std::vector<bool> used(xs.size(), false);
+    for (const std::size_t idx : idxs) {
+        used[idx] = true;
+    }
+    return internal::for_each_selection(f, xs, idxs,
+        [&](std::vector<std::size_t>& is) {
+            return internal::next_k_permutation_idxs(xs.size(), is, used);
+        });
+}
+
+// API search type: for_each_combination : (Int, ([a] -> Bool), [a]) -> Bool
+// fwd bind count: 2
+// Calls f with every combination of the given power in the same order
+// as combinations does, but without creating all of them up front.
+// The same buffer is reused for every call,
+// so f must copy the combination if it wants to keep it.
+// Stops as soon as f returns false.
+// Returns true if all combinations were visited.
+// for_each_combination(2, f, "ABC") calls f with AB AC BC
+template <typename F, typename ContainerIn>
+bool for_each_combination(std::size_t power, F f, const ContainerIn& xs_in)
+{
+    using T = typename ContainerIn::value_type;
+    const std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
+    if (power > xs.size()) {
+        return true;
+    }
+    std::vector<std::size_t> idxs = numbers<std::size_t>(0, power);
+    return internal::for_each_selection(f, xs, idxs,
+        [&](std::vector<std::size_t>& is) {
+            return internal::next_k_combination_idxs(xs.size(), is);
+        });
+}
+
+// API search type: for_each_combination_with_replacement : (Int, ([a] -> Bool), [a]) -> Bool
+// fwd bind count: 2
+// Calls f with every combination using replacement of the given power
+// in the same order as combinations_with_replacement does,
+// but without creating all of them up front.
+// The same buffer is reused for every call.
+// Stops as soon as f returns false.
+// Returns true if all combinations were visited.
+template <typename F, typename ContainerIn>
+bool for_each_combination_with_replacement(std::size_t power, F f,
+    const ContainerIn& xs_in)
+{
+    using T = typename ContainerIn::value_type;
+    const std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
+    if (power > 0 && xs.empty()) {
+        return true;
+    }
+    std::vector<std::size_t> idxs(power, 0);
+    return internal::for_each_selection(f, xs, idxs,
+        [&](std::vector<std::size_t>& is) {
+            return internal::next_k_combination_with_replacement_idxs(xs.size(), is);
+        });
+}
+
+// API search type: for_each_power_set_elem : (([a] -> Bool), [a]) -> Bool
+// fwd bind count: 1
+// Calls f with every subset of xs in the same order
+// as power_set does, but without creating all of them up front.
+// Stops as soon as f returns false.
+// Returns true if all subsets were visited.
+template <typename F, typename ContainerIn>
+bool for_each_power_set_elem(F f, const ContainerIn& xs)
+{
+    for (std::size_t power = 0; power <= size_of_cont(xs); ++power) {
+        if (!for_each_combination(power, f, xs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace internal {
+
+    template <typename ContainerOut, typename ContainerIn, typename ForEach>
+    ContainerOut collect_selections(ForEach for_each_selection,
+        const ContainerIn& xs)
+    {
+        using T = typename ContainerIn::value_type;
+        typedef typename ContainerOut::value_type ContainerOutInner;
+        ContainerOut result;
+        auto it = internal::get_back_inserter(result);
+        for_each_selection([&](const std::vector<T>& selection) {
+            *it = convert_container_and_elems<ContainerOutInner>(selection);
+            return true;
+        },
+            xs);
+        return result;
+    }
+
+} // namespace internal
+
 // API search type: permutations : (Int, [a]) -> [[a]]
 // fwd bind count: 1
 // Generate all possible permutations with a given power.
 // permutations(2, "ABCD") == AB AC AD BA BC BD CA CB CD DA DB DC
+// Check out for_each_permutation to avoid storing all of them.
 template <typename ContainerIn,
     typename T = typename ContainerIn::value_type,
     typename ContainerOut = std::vector<ContainerIn>>
@@ -235,23 +632,18 @@ ContainerOut permutations(std::size_t power, const ContainerIn& xs_in)
 {
     if (power == 0)
         return ContainerOut(1);
-    std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
-    auto idxs = all_idxs(xs);
-    typedef std::vector<std::size_t> idx_vec;
-    auto result_idxss = keep_if(all_unique<idx_vec>,
-        internal::helper_carthesian_product_n_idxs(power, idxs));
-    typedef typename ContainerOut::value_type ContainerOutInner;
-    auto to_result_cont = [&](const std::vector<std::size_t>& indices) {
-        return convert_container_and_elems<ContainerOutInner>(
-            elems_at_idxs(indices, xs));
-    };
-    return transform(to_result_cont, result_idxss);
+    return internal::collect_selections<ContainerOut>(
+        [power](auto f, const ContainerIn& xs) {
+            return for_each_permutation(power, f, xs);
+        },
+        xs_in);
 }
 
 // API search type: combinations : (Int, [a]) -> [[a]]
 // fwd bind count: 1
 // Generate all possible combinations with a given power.
 // combinations(2, "ABCD") == AB AC AD BC BD CD
+// Check out for_each_combination to avoid storing all of them.
 template <typename ContainerIn,
     typename T = typename ContainerIn::value_type,
     typename ContainerOut = std::vector<ContainerIn>>
@@ -259,17 +651,11 @@ ContainerOut combinations(std::size_t power, const ContainerIn& xs_in)
 {
     if (power == 0)
         return ContainerOut(1);
-    std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
-    auto idxs = all_idxs(xs);
-    typedef std::vector<std::size_t> idx_vec;
-    auto result_idxss = keep_if(is_strictly_sorted<idx_vec>,
-        internal::helper_carthesian_product_n_idxs(power, idxs));
-    typedef typename ContainerOut::value_type ContainerOutInner;
-    auto to_result_cont = [&](const std::vector<std::size_t>& indices) {
-        return convert_container_and_elems<ContainerOutInner>(
-            elems_at_idxs(indices, xs));
-    };
-    return transform(to_result_cont, result_idxss);
+    return internal::collect_selections<ContainerOut>(
+        [power](auto f, const ContainerIn& xs) {
+            return for_each_combination(power, f, xs);
+        },
+        xs_in);
 }
 
 // API search type: combinations_with_replacement : (Int, [a]) -> [[a]]
@@ -284,17 +670,45 @@ ContainerOut combinations_with_replacement(std::size_t power,
 {
     if (power == 0)
         return ContainerOut(1);
-    std::vector<T> xs = convert_container<std::vector<T>>(xs_in);
-    auto idxs = all_idxs(xs);
-    typedef std::vector<std::size_t> idx_vec;
-    auto result_idxss = keep_if(is_sorted<idx_vec>,
-        internal::helper_carthesian_product_n_idxs(power, idxs));
-    typedef typename ContainerOut::value_type ContainerOutInner;
-    auto to_result_cont = [&](const std::vector<std::size_t>& indices) {
-        return convert_container_and_elems<ContainerOutInner>(
-            elems_at_idxs(indices, xs));
-    };
-    return transform(to_result_cont, result_idxss);
+    return internal::collect_selections<ContainerOut>(
+        [power](auto f, const ContainerIn& xs) {
+            return for_each_combination_with_replacement(power, f, xs);
+        },
+        xs_in);
+}
+
+// API search type: nth_permutation : (Int, Int, [a]) -> [a]
+// fwd bind count: 2
+// Returns the permutation with the given power
+// at position idx of the sequence returned by permutations,
+// without generating the ones before it.
+// Useful for partitioning the permutations into independent ranges,
+// see also permutation_state.
+// idx must be smaller than the number of permutations.
+// nth_permutation(2, 3, "ABCD") == "BA"
+template <typename ContainerIn>
+ContainerIn nth_permutation(std::size_t power, std::size_t idx,
+    const ContainerIn& xs)
+{
+    return convert_container<ContainerIn>(elems_at_idxs(
+        internal::nth_k_permutation_idxs(size_of_cont(xs), power, idx),
+        convert_container<std::vector<typename ContainerIn::value_type>>(xs)));
+}
+
+// API search type: nth_combination : (Int, Int, [a]) -> [a]
+// fwd bind count: 2
+// Returns the combination with the given power
+// at position idx of the sequence returned by combinations,
+// without generating the ones before it.
+// idx must be smaller than the number of combinations.
+// nth_combination(2, 3, "ABCD") == "BC"
+template <typename ContainerIn>
+ContainerIn nth_combination(std::size_t power, std::size_t idx,
+    const ContainerIn& xs)
+{
+    return convert_container<ContainerIn>(elems_at_idxs(
+        internal::nth_k_combination_idxs(size_of_cont(xs), power, idx),
+        convert_container<std::vector<typename ContainerIn::value_type>>(xs)));
 }
 
 // API search type: power_set : [a] -> [[a]]
@@ -464,7 +878,12 @@ Container fill_left(const T& x, std::size_t min_size, const Container& xs)
 {
     if (min_size <= size_of_cont(xs))
         return xs;
-    return append(replicate<T, Container>(min_size - size_of_cont(xs), x), xs);
+    auto result = internal::new_container_like<Container>(xs);
+    internal::prepare_container(result, min_size);
+    auto it = internal::get_back_inserter(result);
+    it = std::fill_n(it, min_size - size_of_cont(xs), x);
+    std::copy(std::begin(xs), std::end(xs), it);
+    return result;
 }
 
 // API search type: fill_right : (a, Int, [a]) -> [a]
@@ -477,7 +896,12 @@ Container fill_right(const T& x, std::size_t min_size, const Container& xs)
 {
     if (min_size <= size_of_cont(xs))
         return xs;
-    return append(xs, replicate<T, Container>(min_size - size_of_cont(xs), x));
+    auto result = internal::new_container_like<Container>(xs);
+    internal::prepare_container(result, min_size);
+    auto it = internal::get_back_inserter(result);
+    it = std::copy(std::begin(xs), std::end(xs), it);
+    std::fill_n(it, min_size - size_of_cont(xs), x);
+    return result;
 }
 
 // API search type: inits : [a] -> [[a]]
@@ -0,0 +1,228 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cctype>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// The instruction set is selected at compile time,
+// e.g., AVX2 is only used when compiling with -mavx2 or /arch:AVX2.
+#if defined(__AVX2__)
+#define FPLUS_ASCII_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FPLUS_ASCII_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fplus {
+namespace internal {
+
+    // Byte-wise operations on blocks of chars.
+    // Comparisons are signed, so bytes >= 0x80 are less than all ASCII ones.
+#if defined(FPLUS_ASCII_AVX2)
+    struct ascii_block {
+        typedef __m256i vec;
+        static const std::size_t size = 32;
+        static vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+        static void store(char* p, vec v) { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+        static vec set1(char c) { return _mm256_set1_epi8(c); }
+        static vec eq(vec a, vec b) { return _mm256_cmpeq_epi8(a, b); }
+        static vec gt(vec a, vec b) { return _mm256_cmpgt_epi8(a, b); }
+        static vec and_(vec a, vec b) { return _mm256_and_si256(a, b); }
+        static vec or_(vec a, vec b) { return _mm256_or_si256(a, b); }
+        static vec xor_(vec a, vec b) { return _mm256_xor_si256(a, b); }
+        static std::uint32_t mask(vec v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+    };
+#elif defined(FPLUS_ASCII_SSE2)
+    struct ascii_block {
+        typedef __m128i vec;
+        static const std::size_t size = 16;
+        static vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const vec*>(p)); }
+        static void store(char* p, vec v) { _mm_storeu_si128(reinterpret_cast<vec*>(p), v); }
+        static vec set1(char c) { return _mm_set1_epi8(c); }
+        static vec eq(vec a, vec b) { return _mm_cmpeq_epi8(a, b); }
+        static vec gt(vec a, vec b) { return _mm_cmpgt_epi8(a, b); }
+        static vec and_(vec a, vec b) { return _mm_and_si128(a, b); }
+        static vec or_(vec a, vec b) { return _mm_or_si128(a, b); }
+        static vec xor_(vec a, vec b) { return _mm_xor_si128(a, b); }
+        static std::uint32_t mask(vec v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+    };
+#endif
+
+    inline std::size_t ascii_popcount(std::uint32_t x)
+    {
+        std::size_t result = 0;
+        for (; x != 0; x &= x - 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    inline bool ascii_is_whitespace(char c)
+    {
+        return c == ' ' || (c >= 9 && c < 14);
+    }
+
+    template <bool ToUpper>
+    void ascii_change_case_scalar(char* data, std::size_t size)
+    {
+        for (std::size_t idx = 0; idx < size; ++idx) {
+            const auto c = static_cast<unsigned char>(data[idx]);
+            data[idx] = static_cast<char>(ToUpper ? std::toupper(c) : std::tolower(c));
+        }
+    }
+
+    // In other C locales, e.g., a Turkish one,
+    // std::tolower/std::toupper can map ASCII letters differently.
+    inline bool ascii_is_c_locale()
+    {
+        const char* const name = std::setlocale(LC_CTYPE, nullptr);
+        return name != nullptr
+            && (std::strcmp(name, "C") == 0 || std::strcmp(name, "POSIX") == 0);
+    }
+
+    // Gives the same results as std::tolower/std::toupper
+    // applied to every char, which are used unless the C locale is "C".
+    template <bool ToUpper>
+    void ascii_change_case(char* data, std::size_t size)
+    {
+        std::size_t idx = 0;
+#if defined(FPLUS_ASCII_AVX2) || defined(FPLUS_ASCII_SSE2)
+        typedef ascii_block B;
+        if (!ascii_is_c_locale()) {
+            ascii_change_case_scalar<ToUpper>(data, size);
+            return;
+        }
+        const auto first = B::set1(ToUpper ? 'a' - 1 : 'A' - 1);
+        const auto last = B::set1(ToUpper ? 'z' + 1 : 'Z' + 1);
+        const auto case_bit = B::set1(0x20);
+        for (; idx + B::size <= size; idx += B::size) {
+            const auto v = B::load(data + idx);
+            if (B::mask(v) != 0) {
+                ascii_change_case_scalar<ToUpper>(data + idx, B::size);
+                continue;
+            }
+            const auto is_letter = B::and_(B::gt(v, first), B::gt(last, v));
+            B::store(data + idx, B::xor_(v, B::and_(is_letter, case_bit)));
+        }
+#endif
+        ascii_change_case_scalar<ToUpper>(data + idx, size - idx);
+    }
+
+    // Index of the first non-whitespace char, size if there is none.
+    inline std::size_t ascii_skip_whitespace_left(const char* data, std::size_t size)
+    {
+        std::size_t idx = 0;
+#if defined(FPLUS_ASCII_AVX2) || defined(FPLUS_ASCII_SSE2)
+        typedef ascii_block B;
+        const auto space = B::set1(' ');
+        const auto tab_minus_1 = B::set1(8);
+        const auto cr_plus_1 = B::set1(14);
+        const auto all_whitespace = B::mask(B::eq(space, space));
+        for (; idx + B::size <= size; idx += B::size) {
+            const auto v = B::load(data + idx);
+            const auto is_ws = B::or_(B::eq(v, space),
+                B::and_(B::gt(v, tab_minus_1), B::gt(cr_plus_1, v)));
+            if (B::mask(is_ws) != all_whitespace) {
+                break;
+            }
+        }
+#endif
+        while (idx < size && ascii_is_whitespace(data[idx])) {
+            ++idx;
+        }
+        return idx;
+    }
+
+    // Index after the last non-whitespace char, 0 if there is none.
+    inline std::size_t ascii_skip_whitespace_right(const char* data, std::size_t size)
+    {
+        std::size_t idx = size;
+#if defined(FPLUS_ASCII_AVX2) || defined(FPLUS_ASCII_SSE2)
+        typedef ascii_block B;
+        const auto space = B::set1(' ');
+        const auto tab_minus_1 = B::set1(8);
+        const auto cr_plus_1 = B::set1(14);
+        const auto all_whitespace = B::mask(B::eq(space, space));
+        for (; idx >= B::size; idx -= B::size) {
+            const auto v = B::load(data + idx - B::size);
+            const auto is_ws = B::or_(B::eq(v, space),
+                B::and_(B::gt(v, tab_minus_1), B::gt(cr_plus_1, v)));
+            if (B::mask(is_ws) != all_whitespace) {
+                break;
+            }
+        }
+#endif
+        while (idx > 0 && ascii_is_whitespace(data[idx - 1])) {
+            --idx;
+        }
+        return idx;
+    }
+
+    // Number of "\n", "\r\n" and "\r" line breaks.
+    inline std::size_t ascii_count_line_breaks(const char* data, std::size_t size)
+    {
+        std::size_t result = 0;
+        std::size_t idx = 0;
+#if defined(FPLUS_ASCII_AVX2) || defined(FPLUS_ASCII_SSE2)
+        typedef ascii_block B;
+        const auto lf = B::set1('\n');
+        const auto cr = B::set1('\r');
+        // The char after each block is needed to detect "\r\n".
+        for (; idx + B::size < size; idx += B::size) {
+            const auto v = B::load(data + idx);
+            const auto next = B::load(data + idx + 1);
+            const auto is_cr = B::eq(v, cr);
+            const auto is_crlf = B::and_(is_cr, B::eq(next, lf));
+            result += ascii_popcount(B::mask(B::eq(v, lf)))
+                + ascii_popcount(B::mask(is_cr))
+                - ascii_popcount(B::mask(is_crlf));
+        }
+#endif
+        for (; idx < size; ++idx) {
+            if (data[idx] == '\n') {
+                ++result;
+            } else if (data[idx] == '\r' && (idx + 1 == size || data[idx + 1] != '\n')) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // Replaces "\r\n" and "\r" with "\n".
+    // memchr, which std::char_traits<char>::find uses,
+    // is vectorized in the common C libraries.
+    inline std::string ascii_clean_newlines(const char* data, std::size_t size)
+    {
+        std::string result;
+        result.reserve(size);
+        const char* const end = data + size;
+        const char* it = data;
+        while (it != end) {
+            const char* const cr = std::char_traits<char>::find(
+                it, static_cast<std::size_t>(end - it), '\r');
+            if (cr == nullptr) {
+                result.append(it, end);
+                break;
+            }
+            result.append(it, cr);
+            result.push_back('\n');
+            it = cr + 1;
+            if (it != end && *it == '\n') {
+                ++it;
+            }
+        }
+        return result;
+    }
+
+} // namespace internal
+} // namespace fplus
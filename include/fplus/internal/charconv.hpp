@@ -0,0 +1,38 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <type_traits>
+
+// std::to_chars and std::from_chars are used if the standard library
+// provides them for integral and floating point types,
+// which is indicated by __cpp_lib_to_chars.
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L) \
+    && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace fplus {
+namespace internal {
+
+    // Arithmetic types that are read and shown as numbers.
+    // bool and the character types are streamed differently.
+    template <typename T>
+    using is_chars_convertible = std::integral_constant<bool,
+        std::is_arithmetic<T>::value
+            && !std::is_same<T, bool>::value
+            && !std::is_same<T, char>::value
+            && !std::is_same<T, signed char>::value
+            && !std::is_same<T, unsigned char>::value
+            && !std::is_same<T, wchar_t>::value
+            && !std::is_same<T, char16_t>::value
+            && !std::is_same<T, char32_t>::value>;
+
+} // namespace internal
+} // namespace fplus
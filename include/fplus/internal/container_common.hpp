@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <numeric>
 #include <type_traits>
 
@@ -53,5 +54,33 @@ namespace internal {
 
         internal::accumulate(begin, end, init, g);
     }
+
+    // Combines init and g(0), ..., g(n-1) using independent lanes.
+    // With only one accumulator, every step would depend on the previous one,
+    // and the compiler is not allowed to reorder floating-point additions.
+    // init is used exactly once, but the order of the elements changes,
+    // so this is only valid if f is associative and commutative.
+    template <typename F, typename Acc, typename G>
+    Acc reduce_in_lanes(F f, const Acc& init, std::size_t n, G g)
+    {
+        const std::size_t lanes = 8;
+        Acc result = init;
+        std::size_t idx = 0;
+        if (n >= lanes) {
+            Acc acc[lanes] = { g(0), g(1), g(2), g(3), g(4), g(5), g(6), g(7) };
+            for (idx = lanes; idx + lanes <= n; idx += lanes) {
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    acc[lane] = f(acc[lane], g(idx + lane));
+                }
+            }
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                result = f(result, acc[lane]);
+            }
+        }
+        for (; idx < n; ++idx) {
+            result = f(result, g(idx));
+        }
+        return result;
+    }
 }
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iterator>
 #include <utility>
 
@@ -26,5 +27,22 @@ namespace internal {
         };
         return fplus::transform(attach_label, grouped);
     }
+
+    // The parts of xs use its allocator.
+    template <typename Container, typename T>
+    Container singleton_like(const T& x, const Container& xs)
+    {
+        auto result = new_container_like<Container>(xs);
+        *get_back_inserter(result) = x;
+        return result;
+    }
+
+    template <typename Container, typename Iterator>
+    Container segment_like(Iterator first, Iterator last, const Container& xs)
+    {
+        auto result = new_container_like<Container>(xs);
+        std::copy(first, last, get_back_inserter(result));
+        return result;
+    }
 }
 }
@@ -0,0 +1,369 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <fplus/internal/invoke.hpp>
+#include <fplus/maybe.hpp>
+#include <fplus/span_view.hpp>
+#include <fplus/transform.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Files are memory-mapped on POSIX systems.
+// Elsewhere, and for files that can not be mapped (e.g., pipes),
+// the content is read into memory instead.
+#if defined(__unix__) || defined(__APPLE__)
+#define FPLUS_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fplus {
+
+// How the content of a mapped file will be accessed.
+// Passed on to the operating system, which can e.g. read ahead.
+enum class mapped_file_access {
+    normal,
+    sequential,
+    random
+};
+
+namespace internal {
+
+    // Owns the mapping (or the read content) of a file.
+    class file_mapping {
+    public:
+        file_mapping(const std::string& filename, mapped_file_access access)
+            : data_(nullptr)
+            , size_(0)
+            , is_mapped_(false)
+            , is_open_(false)
+            , buffer_()
+        {
+#if defined(FPLUS_MAPPED_FILE_POSIX)
+            if (map(filename, access)) {
+                return;
+            }
+#else
+            (void)access;
+#endif
+            read(filename);
+        }
+        ~file_mapping()
+        {
+#if defined(FPLUS_MAPPED_FILE_POSIX)
+            if (is_mapped_) {
+                ::munmap(const_cast<char*>(data_), size_);
+            }
+#endif
+        }
+        file_mapping(const file_mapping&) = delete;
+        file_mapping& operator=(const file_mapping&) = delete;
+
+        bool is_open() const { return is_open_; }
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+    private:
+#if defined(FPLUS_MAPPED_FILE_POSIX)
+        bool map(const std::string& filename, mapped_file_access access)
+        {
+            const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return false;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+                ::close(fd);
+                return false;
+            }
+            const auto size = static_cast<std::size_t>(info.st_size);
+            void* const address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                return false;
+            }
+            if (access != mapped_file_access::normal) {
+                ::madvise(address, size,
+                    access == mapped_file_access::sequential
+                        ? MADV_SEQUENTIAL
+                        : MADV_RANDOM);
+            }
+            data_ = static_cast<const char*>(address);
+            size_ = size;
+            is_mapped_ = true;
+            is_open_ = true;
+            return true;
+        }
+#endif
+        void read(const std::string& filename)
+        {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.good()) {
+                return;
+            }
+            char chunk[1 << 16];
+            while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+                buffer_.insert(buffer_.end(), chunk, chunk + file.gcount());
+            }
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+            is_open_ = true;
+        }
+        const char* data_;
+        std::size_t size_;
+        bool is_mapped_;
+        bool is_open_;
+        std::vector<char> buffer_;
+    };
+
+} // namespace internal
+
+// The read-only content of a file as one contiguous range of bytes,
+// memory-mapped if possible.
+// Copies share the mapping, which is released with the last one.
+// The content can be used directly with functions taking containers
+// or with the views returned by view(), e.g.:
+// const mapped_file file("huge.log");
+// for_each_line_view(f, false, file.view());
+template <typename T>
+class basic_mapped_file {
+public:
+    static_assert(sizeof(T) == 1, "Only files of bytes can be mapped.");
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T& reference;
+    typedef const T& const_reference;
+    typedef const T* pointer;
+    typedef const T* const_pointer;
+    typedef const T* iterator;
+    typedef const T* const_iterator;
+
+    explicit basic_mapped_file(const std::string& filename,
+        mapped_file_access access = mapped_file_access::sequential)
+        : mapping_(std::make_shared<internal::file_mapping>(filename, access))
+    {
+    }
+
+    // False if the file could not be opened.
+    bool is_open() const { return mapping_->is_open(); }
+    const T* data() const { return reinterpret_cast<const T*>(mapping_->data()); }
+    std::size_t size() const { return mapping_->size(); }
+    bool empty() const { return size() == 0; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size(); }
+    const T& operator[](std::size_t idx) const { return data()[idx]; }
+
+    // Only valid as long as a copy of this file object exists.
+    span_view<const T> view() const { return span_view<const T>(data(), size()); }
+
+private:
+    std::shared_ptr<internal::file_mapping> mapping_;
+};
+
+typedef basic_mapped_file<char> mapped_file;
+typedef basic_mapped_file<std::uint8_t> mapped_binary_file;
+
+// API search type: read_text_file_view : String -> Io (Maybe MappedFile)
+// Returns a function that (when called) maps a text file into memory.
+// No line break conversion is done.
+// The function returns nothing if the file could not be opened.
+inline std::function<maybe<mapped_file>()> read_text_file_view(
+    const std::string& filename)
+{
+    return [filename]() -> maybe<mapped_file> {
+        mapped_file file(filename);
+        if (!file.is_open())
+            return {};
+        return file;
+    };
+}
+
+// API search type: read_binary_file_view : String -> Io (Maybe MappedBinaryFile)
+// Returns a function that (when called) maps a binary file into memory.
+// The function returns nothing if the file could not be opened.
+inline std::function<maybe<mapped_binary_file>()> read_binary_file_view(
+    const std::string& filename)
+{
+    return [filename]() -> maybe<mapped_binary_file> {
+        mapped_binary_file file(filename);
+        if (!file.is_open())
+            return {};
+        return file;
+    };
+}
+
+namespace internal {
+
+    // Splits data into about n_ranges ranges of similar size,
+    // each one ending directly after a line break (except the last one).
+    inline std::vector<std::pair<std::size_t, std::size_t>> line_aligned_ranges(
+        const char* data, std::size_t size, std::size_t n_ranges)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::size_t begin = 0;
+        for (std::size_t i = 1; i < n_ranges && begin < size; ++i) {
+            const std::size_t target = std::max(begin, size / n_ranges * i);
+            const auto line_break = find_line_break(data, size, target);
+            const std::size_t end = line_break.first + line_break.second;
+            if (end >= size) {
+                break;
+            }
+            if (end > begin) {
+                ranges.emplace_back(begin, end);
+                begin = end;
+            }
+        }
+        ranges.emplace_back(begin, size);
+        return ranges;
+    }
+
+    // Calls f with every line in [begin, end).
+    // Lines are split like split_lines does for the whole data,
+    // i.e., only the last range ends with a possibly empty line.
+    template <typename F>
+    void for_each_line_in_range(F f, bool allow_empty,
+        const char* data, std::size_t size,
+        std::size_t begin, std::size_t end, std::string& line)
+    {
+        const bool is_last = end == size;
+        std::size_t pos = begin;
+        for (;;) {
+            const auto line_break = find_line_break(data, end, pos);
+            if (line_break.second == 0 && !is_last) {
+                return;
+            }
+            if (allow_empty || line_break.first != pos) {
+                line.assign(data + pos, data + line_break.first);
+                internal::invoke(f, static_cast<const std::string&>(line));
+            }
+            if (line_break.second == 0) {
+                return;
+            }
+            pos = line_break.first + line_break.second;
+            if (pos == end && !is_last) {
+                return;
+            }
+        }
+    }
+
+    template <typename Acc, typename F>
+    Acc fold_lines_in_range(F f, const Acc& init, bool allow_empty,
+        const char* data, std::size_t size,
+        std::size_t begin, std::size_t end)
+    {
+        Acc acc = init;
+        std::string line;
+        for_each_line_in_range([&](const std::string& l) {
+            acc = internal::invoke(f, acc, l);
+        },
+            allow_empty, data, size, begin, end, line);
+        return acc;
+    }
+
+    inline std::size_t file_lines_n_threads()
+    {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+} // namespace internal
+
+// API search type: transform_file_lines_parallelly : ((String -> a), Bool, String) -> Io (Maybe [a])
+// Returns a function that (when called) applies f to all lines of a file
+// using all hardware threads, and returns the results in line order.
+// The file is mapped into memory and split into line-aligned byte ranges,
+// which are processed in parallel, so reading and splitting the lines
+// does not happen on a single thread.
+// The lines are the same as with read_text_file_lines.
+// The function returns nothing if the file could not be opened.
+// If f throws, the first exception is rethrown.
+template <typename F,
+    typename Y = std::decay_t<internal::invoke_result_t<F, const std::string&>>>
+std::function<maybe<std::vector<Y>>()> transform_file_lines_parallelly(
+    F f, bool allow_empty, const std::string& filename)
+{
+    return [f, allow_empty, filename]() -> maybe<std::vector<Y>> {
+        const mapped_file file(filename);
+        if (!file.is_open())
+            return {};
+        const std::size_t n_threads = internal::file_lines_n_threads();
+        const auto ranges = internal::line_aligned_ranges(
+            file.data(), file.size(), 4 * n_threads);
+        auto results = transform_parallelly_n_threads(n_threads,
+            [&](const std::pair<std::size_t, std::size_t>& range) {
+                std::vector<Y> ys;
+                std::string line;
+                internal::for_each_line_in_range([&](const std::string& l) {
+                    ys.push_back(internal::invoke(f, l));
+                },
+                    allow_empty, file.data(), file.size(),
+                    range.first, range.second, line);
+                return ys;
+            },
+            ranges);
+        std::size_t result_size = 0;
+        for (const auto& ys : results) {
+            result_size += ys.size();
+        }
+        std::vector<Y> result;
+        result.reserve(result_size);
+        for (auto& ys : results) {
+            std::move(std::begin(ys), std::end(ys), std::back_inserter(result));
+        }
+        return result;
+    };
+}
+
+// API search type: fold_file_lines_parallelly : (((a, String) -> a), ((a, a) -> a), a, Bool, String) -> Io (Maybe a)
+// Returns a function that (when called) folds over the lines of a file
+// using all hardware threads.
+// Every thread folds the lines of its byte ranges with f, starting from init,
+// and the partial results are then combined in line order.
+// So init has to be an identity of combine, and combine must be associative.
+// fold_file_lines_parallelly(
+//     (acc, line) -> acc + 1, (+), 0, true, filename)
+// counts the lines of a file.
+// The function returns nothing if the file could not be opened.
+template <typename F, typename Combine, typename Acc>
+std::function<maybe<Acc>()> fold_file_lines_parallelly(F f, Combine combine,
+    const Acc& init, bool allow_empty, const std::string& filename)
+{
+    return [f, combine, init, allow_empty, filename]() -> maybe<Acc> {
+        const mapped_file file(filename);
+        if (!file.is_open())
+            return {};
+        const std::size_t n_threads = internal::file_lines_n_threads();
+        const auto ranges = internal::line_aligned_ranges(
+            file.data(), file.size(), 4 * n_threads);
+        const auto results = transform_parallelly_n_threads(n_threads,
+            [&](const std::pair<std::size_t, std::size_t>& range) {
+                return internal::fold_lines_in_range(f, init, allow_empty,
+                    file.data(), file.size(), range.first, range.second);
+            },
+            ranges);
+        Acc acc = init;
+        for (const auto& result : results) {
+            acc = internal::invoke(combine, acc, result);
+        }
+        return acc;
+    };
+}
+
+} // namespace fplus
@@ -0,0 +1,485 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <fplus/aligned_allocator.hpp>
+#include <fplus/container_common.hpp>
+#include <fplus/pairs.hpp>
+#include <fplus/span_view.hpp>
+#include <fplus/transform.hpp>
+
+#include <fplus/internal/invoke.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fplus {
+
+namespace internal {
+
+    // Explicit template arguments meant for a generic overload,
+    // e.g., transform<F, const std::vector<int>&>,
+    // must not instantiate a matrix of elements it can not hold.
+    template <typename T>
+    struct is_matrix_element
+        : std::integral_constant<bool,
+              std::is_same<T, std::remove_cv_t<std::remove_reference_t<T>>>::value
+                  && !std::is_same<T, bool>::value> {
+    };
+
+    template <typename T, typename Result>
+    using enable_if_matrix_element_t = std::enable_if_t<is_matrix_element<T>::value, Result>;
+
+} // namespace internal
+
+// A two-dimensional table with all elements in one contiguous block
+// in row-major order, i.e., m(row, col) == m.data()[row * m.cols() + col].
+// Iterating over a matrix visits all elements row by row.
+// Unlike std::vector<std::vector<T>>, it needs only one allocation,
+// and neighboring rows are neighbors in memory.
+// The first element is aligned to a cache line,
+// so the compiler can use aligned SIMD loads and stores.
+template <typename T>
+class matrix {
+public:
+    static_assert(!std::is_same<T, bool>::value,
+        "matrix<bool> is not supported, use e.g. matrix<unsigned char>.");
+    static constexpr std::size_t alignment = 64;
+    typedef std::vector<T, aligned_allocator<T, alignment>> storage_type;
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    matrix()
+        : n_rows_(0)
+        , n_cols_(0)
+        , data_()
+    {
+    }
+    matrix(std::size_t n_rows, std::size_t n_cols, const T& value = T())
+        : n_rows_(n_rows)
+        , n_cols_(n_cols)
+        , data_(n_rows * n_cols, value)
+    {
+    }
+    // The elements have to be given in row-major order.
+    template <typename Alloc>
+    matrix(std::size_t n_rows, std::size_t n_cols, std::vector<T, Alloc> data)
+        : n_rows_(n_rows)
+        , n_cols_(n_cols)
+        , data_(to_storage(std::move(data)))
+    {
+        assert(data_.size() == n_rows * n_cols);
+    }
+
+    std::size_t rows() const { return n_rows_; }
+    std::size_t cols() const { return n_cols_; }
+    std::size_t size() const { return data_.size(); }
+    bool empty() const { return data_.empty(); }
+    bool is_square() const { return n_rows_ == n_cols_; }
+
+    T& operator()(std::size_t row, std::size_t col)
+    {
+        assert(row < n_rows_ && col < n_cols_);
+        return data_[row * n_cols_ + col];
+    }
+    const T& operator()(std::size_t row, std::size_t col) const
+    {
+        assert(row < n_rows_ && col < n_cols_);
+        return data_[row * n_cols_ + col];
+    }
+
+    T* data() { return data_.data(); }
+    const T* data() const { return data_.data(); }
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    span_view<T> row(std::size_t idx)
+    {
+        assert(idx < n_rows_);
+        return span_view<T>(data() + idx * n_cols_, n_cols_);
+    }
+    span_view<const T> row(std::size_t idx) const
+    {
+        assert(idx < n_rows_);
+        return span_view<const T>(data() + idx * n_cols_, n_cols_);
+    }
+
+    // Only for square matrices, see transpose.
+    void transpose_square_in_place();
+
+private:
+    static storage_type to_storage(storage_type&& data)
+    {
+        return std::move(data);
+    }
+    template <typename Alloc>
+    static storage_type to_storage(std::vector<T, Alloc>&& data)
+    {
+        return storage_type(std::make_move_iterator(data.begin()),
+            std::make_move_iterator(data.end()));
+    }
+
+    std::size_t n_rows_;
+    std::size_t n_cols_;
+    storage_type data_;
+};
+
+template <typename T>
+constexpr std::size_t matrix<T>::alignment;
+
+template <typename T>
+bool operator==(const matrix<T>& xs, const matrix<T>& ys)
+{
+    return xs.rows() == ys.rows() && xs.cols() == ys.cols()
+        && std::equal(xs.begin(), xs.end(), ys.begin());
+}
+
+template <typename T>
+bool operator!=(const matrix<T>& xs, const matrix<T>& ys)
+{
+    return !(xs == ys);
+}
+
+namespace internal {
+
+    // Tiles above the diagonal are swapped with the ones below it.
+    template <typename T>
+    void transpose_square_in_place(T* data, std::size_t n)
+    {
+        const std::size_t tile_size = 32;
+        for (std::size_t row_0 = 0; row_0 < n; row_0 += tile_size) {
+            const std::size_t row_end = std::min(n, row_0 + tile_size);
+            for (std::size_t col_0 = row_0; col_0 < n; col_0 += tile_size) {
+                const std::size_t col_end = std::min(n, col_0 + tile_size);
+                for (std::size_t row = row_0; row < row_end; ++row) {
+                    for (std::size_t col = std::max(col_0, row + 1); col < col_end; ++col) {
+                        using std::swap;
+                        swap(data[row * n + col], data[col * n + row]);
+                    }
+                }
+            }
+        }
+    }
+
+    // The elements are overwritten anyway,
+    // so they are only copied if they can not be default-constructed.
+    template <typename T>
+    typename matrix<T>::storage_type storage_like(std::true_type, const matrix<T>& m)
+    {
+        return typename matrix<T>::storage_type(m.size());
+    }
+
+    template <typename T>
+    typename matrix<T>::storage_type storage_like(std::false_type, const matrix<T>& m)
+    {
+        return typename matrix<T>::storage_type(m.begin(), m.end());
+    }
+
+    template <typename T>
+    typename matrix<T>::storage_type storage_like(const matrix<T>& m)
+    {
+        return storage_like(std::is_default_constructible<T>(), m);
+    }
+
+    // Creates n elements with g(idx).
+    // A plain loop over already existing elements is easier
+    // to vectorize for the compiler than repeated push_backs.
+    template <typename T, typename G>
+    typename matrix<T>::storage_type generate_storage(std::true_type,
+        std::size_t n, G g)
+    {
+        typename matrix<T>::storage_type result(n);
+        T* const dst = result.data();
+        for (std::size_t idx = 0; idx < n; ++idx) {
+            dst[idx] = g(idx);
+        }
+        return result;
+    }
+
+    template <typename T, typename G>
+    typename matrix<T>::storage_type generate_storage(std::false_type,
+        std::size_t n, G g)
+    {
+        typename matrix<T>::storage_type result;
+        result.reserve(n);
+        for (std::size_t idx = 0; idx < n; ++idx) {
+            result.push_back(g(idx));
+        }
+        return result;
+    }
+
+    template <typename T, typename G>
+    typename matrix<T>::storage_type generate_storage(std::size_t n, G g)
+    {
+        return generate_storage<T>(std::is_default_constructible<T>(), n, g);
+    }
+
+} // namespace internal
+
+template <typename T>
+void matrix<T>::transpose_square_in_place()
+{
+    assert(is_square());
+    internal::transpose_square_in_place(data(), n_rows_);
+}
+
+// API search type: transpose : Matrix a -> Matrix a
+// Transpose a matrix, tile by tile to make good use of the CPU cache.
+// transpose(matrix(2, 3, [1,2,3,4,5,6])) == matrix(3, 2, [1,4,2,5,3,6])
+template <typename T>
+internal::enable_if_matrix_element_t<T, matrix<T>> transpose(const matrix<T>& m)
+{
+    const T* const src = m.data();
+    auto data = internal::storage_like(m);
+    T* const dst = data.data();
+    const std::size_t n_rows = m.rows();
+    const std::size_t n_cols = m.cols();
+    internal::for_each_transpose_tile(n_rows, n_cols,
+        [src, dst, n_rows, n_cols](std::size_t row, std::size_t col) {
+            dst[col * n_rows + row] = src[row * n_cols + col];
+        });
+    return matrix<T>(n_cols, n_rows, std::move(data));
+}
+
+// Square matrices passed as rvalue are transposed in place.
+template <typename T>
+internal::enable_if_matrix_element_t<T, matrix<T>> transpose(matrix<T>&& m)
+{
+    if (!m.is_square()) {
+        return transpose(static_cast<const matrix<T>&>(m));
+    }
+    m.transpose_square_in_place();
+    return std::move(m);
+}
+
+// API search type: transform : ((a -> b), Matrix a) -> Matrix b
+// Apply a function to every element of a matrix.
+// transform((*2), matrix(1, 3, [1, 3, 4])) == matrix(1, 3, [2, 6, 8])
+template <typename F, typename T,
+    typename TOut = std::decay_t<internal::invoke_result_t<F, const T&>>>
+internal::enable_if_matrix_element_t<T, matrix<TOut>> transform(F f, const matrix<T>& m)
+{
+    const T* const src = m.data();
+    return matrix<TOut>(m.rows(), m.cols(),
+        internal::generate_storage<TOut>(m.size(),
+            [&f, src](std::size_t idx) -> TOut {
+                return internal::invoke(f, src[idx]);
+            }));
+}
+
+// The generic transform would be a better match for non-const matrices.
+template <typename F, typename T,
+    typename TOut = std::decay_t<internal::invoke_result_t<F, const T&>>>
+internal::enable_if_matrix_element_t<T, matrix<TOut>> transform(F f, matrix<T>& m)
+{
+    return transform(f, static_cast<const matrix<T>&>(m));
+}
+
+namespace internal {
+
+    template <typename F, typename T>
+    matrix<T> transform_in_place(std::true_type, F f, matrix<T>&& m)
+    {
+        for (auto& x : m) {
+            x = internal::invoke(f, x);
+        }
+        return std::move(m);
+    }
+
+    template <typename F, typename T>
+    auto transform_in_place(std::false_type, F f, matrix<T>&& m)
+    {
+        return fplus::transform(f, static_cast<const matrix<T>&>(m));
+    }
+
+    // Sums and products of numbers do not depend on the order
+    // of the elements (up to floating-point rounding),
+    // so they can be calculated in independent lanes.
+    template <typename F, typename T>
+    struct is_lane_reduction
+        : std::integral_constant<bool,
+              std::is_arithmetic<T>::value
+                  && (std::is_same<F, std::plus<T>>::value
+                      || std::is_same<F, std::plus<>>::value
+                      || std::is_same<F, std::multiplies<T>>::value
+                      || std::is_same<F, std::multiplies<>>::value)> {
+    };
+
+    template <typename F, typename T>
+    T reduce_contiguous(std::true_type, F f, const T& init,
+        const T* xs, std::size_t size)
+    {
+        return reduce_in_lanes(f, init, size,
+            [xs](std::size_t idx) { return xs[idx]; });
+    }
+
+    template <typename F, typename T>
+    T reduce_contiguous(std::false_type, F f, const T& init,
+        const T* xs, std::size_t size)
+    {
+        return internal::accumulate(xs, xs + size, init,
+            [&f](const T& acc, const T& x) { return internal::invoke(f, acc, x); });
+    }
+
+    template <typename F, typename T>
+    T reduce_contiguous(F f, const T& init, const T* xs, std::size_t size)
+    {
+        return reduce_contiguous(is_lane_reduction<F, T>(), f, init, xs, size);
+    }
+
+} // namespace internal
+
+// If the element type stays the same,
+// the elements of a matrix passed as rvalue are replaced in place.
+template <typename F, typename T,
+    typename TOut = std::decay_t<internal::invoke_result_t<F, const T&>>>
+internal::enable_if_matrix_element_t<T, matrix<TOut>> transform(F f, matrix<T>&& m)
+{
+    return internal::transform_in_place(std::is_same<T, TOut>(), f, std::move(m));
+}
+
+// API search type: zip_with : (((a, b) -> c), Matrix a, Matrix b) -> Matrix c
+// Zip two matrices of the same shape using a binary function.
+// zip_with((+), matrix(1, 2, [1, 2]), matrix(1, 2, [5, 6])) == matrix(1, 2, [6, 8])
+// Unsafe! Both matrices must have the same shape.
+template <typename F, typename X, typename Y,
+    typename TOut = std::decay_t<internal::invoke_result_t<F, const X&, const Y&>>>
+internal::enable_if_matrix_element_t<X,
+    internal::enable_if_matrix_element_t<Y, matrix<TOut>>>
+zip_with(F f, const matrix<X>& xs, const matrix<Y>& ys)
+{
+    assert(xs.rows() == ys.rows() && xs.cols() == ys.cols());
+    const X* const src_xs = xs.data();
+    const Y* const src_ys = ys.data();
+    return matrix<TOut>(xs.rows(), xs.cols(),
+        internal::generate_storage<TOut>(xs.size(),
+            [&f, src_xs, src_ys](std::size_t idx) -> TOut {
+                return internal::invoke(f, src_xs[idx], src_ys[idx]);
+            }));
+}
+
+// API search type: reduce : (((a, a) -> a), a, Matrix a) -> a
+// Combines the initial value and all elements of the matrix
+// from left to right using the given function, like the generic reduce.
+// Sums and products (std::plus, std::multiplies) of numbers
+// are calculated in several independent lanes instead,
+// which allows the compiler to vectorize them.
+// For floating-point numbers the result can thus differ by rounding.
+// reduce((+), 0, matrix(2, 2, [1, 2, 3, 4])) == 10
+template <typename F, typename T>
+internal::enable_if_matrix_element_t<T, T> reduce(F f, const T& init, const matrix<T>& m)
+{
+    return internal::reduce_contiguous(f, init, m.data(), m.size());
+}
+
+// API search type: reduce_rows : (((a, a) -> a), a, Matrix a) -> [a]
+// fwd bind count: 2
+// Reduces every row of a matrix to one value, see reduce.
+// reduce_rows((+), 0, matrix(2, 3, [1, 2, 3, 4, 5, 6])) == [6, 15]
+template <typename F, typename T>
+std::vector<T> reduce_rows(F f, const T& init, const matrix<T>& m)
+{
+    std::vector<T> result;
+    result.reserve(m.rows());
+    const std::size_t n_cols = m.cols();
+    for (std::size_t row = 0; row < m.rows(); ++row) {
+        result.push_back(internal::reduce_contiguous(
+            f, init, m.data() + row * n_cols, n_cols));
+    }
+    return result;
+}
+
+// API search type: reduce_cols : (((a, a) -> a), a, Matrix a) -> [a]
+// fwd bind count: 2
+// Reduces every column of a matrix to one value, see reduce.
+// The matrix is traversed row by row,
+// updating the results of all columns at once.
+// reduce_cols((+), 0, matrix(2, 3, [1, 2, 3, 4, 5, 6])) == [5, 7, 9]
+template <typename F, typename T>
+std::vector<T> reduce_cols(F f, const T& init, const matrix<T>& m)
+{
+    const std::size_t n_cols = m.cols();
+    std::vector<T> result(n_cols, init);
+    T* const acc = result.data();
+    for (std::size_t row = 0; row < m.rows(); ++row) {
+        const T* const xs = m.data() + row * n_cols;
+        for (std::size_t col = 0; col < n_cols; ++col) {
+            acc[col] = f(acc[col], xs[col]);
+        }
+    }
+    return result;
+}
+
+// API search type: inner_product : (a, Matrix a, Matrix a) -> a
+// Sums up the products of the corresponding elements of two matrices.
+// inner_product(0, matrix(1, 3, [1, 2, 3]), matrix(1, 3, [4, 5, 6])) == 32
+// Unsafe! Both matrices must have the same shape.
+template <typename T, typename Z>
+internal::enable_if_matrix_element_t<T, Z> inner_product(
+    const Z& value, const matrix<T>& xs, const matrix<T>& ys)
+{
+    assert(xs.rows() == ys.rows() && xs.cols() == ys.cols());
+    const T* const src_xs = xs.data();
+    const T* const src_ys = ys.data();
+    return value
+        + internal::reduce_in_lanes(std::plus<Z>(), static_cast<Z>(0), xs.size(),
+            [src_xs, src_ys](std::size_t idx) {
+                return static_cast<Z>(src_xs[idx] * src_ys[idx]);
+            });
+}
+
+// API search type: matrix_from_rows : [[a]] -> Matrix a
+// fwd bind count: 0
+// Copies a table given as a sequence of rows into a matrix.
+// matrix_from_rows([[1, 2, 3], [4, 5, 6]]) == matrix(2, 3, [1, 2, 3, 4, 5, 6])
+// Unsafe! All rows must have the same length.
+template <typename T, typename Alloc, typename OuterAlloc>
+matrix<T> matrix_from_rows(const std::vector<std::vector<T, Alloc>, OuterAlloc>& rows)
+{
+    const std::size_t n_cols = rows.empty() ? 0 : rows.front().size();
+    typename matrix<T>::storage_type data;
+    data.reserve(rows.size() * n_cols);
+    for (const auto& row : rows) {
+        assert(row.size() == n_cols);
+        data.insert(data.end(), row.begin(), row.end());
+    }
+    return matrix<T>(rows.size(), n_cols, std::move(data));
+}
+
+// API search type: matrix_to_rows : Matrix a -> [[a]]
+// fwd bind count: 0
+// Copies the rows of a matrix into separate vectors.
+// matrix_to_rows(matrix(2, 3, [1, 2, 3, 4, 5, 6])) == [[1, 2, 3], [4, 5, 6]]
+template <typename T>
+std::vector<std::vector<T>> matrix_to_rows(const matrix<T>& m)
+{
+    std::vector<std::vector<T>> result;
+    result.reserve(m.rows());
+    for (std::size_t row = 0; row < m.rows(); ++row) {
+        const auto xs = m.row(row);
+        result.emplace_back(xs.begin(), xs.end());
+    }
+    return result;
+}
+
+} // namespace fplus
@@ -53,6 +53,37 @@ ContainerOut zip_with(F f, const ContainerIn1& xs, const ContainerIn2& ys)
     return result;
 }
 
+// API search type: zip_with_into : (((a, b) -> c), [a], [b], [c]) -> ()
+// Same as zip_with, but writes the results into zs
+// (a container or an output iterator), like transform_into does.
+template <typename ContainerIn1, typename ContainerIn2, typename F,
+    typename OutputIt,
+    internal::enable_if_output_iterator_t<OutputIt> = 0>
+OutputIt zip_with_into(F f, const ContainerIn1& xs, const ContainerIn2& ys,
+    OutputIt it)
+{
+    internal::trigger_static_asserts<internal::zip_with_tag, F,
+        typename ContainerIn1::value_type, typename ContainerIn2::value_type>();
+    auto itXs = std::begin(xs);
+    auto itYs = std::begin(ys);
+    for (; itXs != std::end(xs) && itYs != std::end(ys); ++itXs, ++itYs) {
+        *it = internal::invoke(f, *itXs, *itYs);
+        ++it;
+    }
+    return it;
+}
+
+template <typename ContainerIn1, typename ContainerIn2, typename F,
+    typename ContainerOut,
+    internal::enable_if_output_container_t<ContainerOut> = 0>
+void zip_with_into(F f, const ContainerIn1& xs, const ContainerIn2& ys,
+    ContainerOut& zs)
+{
+    zs.clear();
+    internal::prepare_container(zs, std::min(size_of_cont(xs), size_of_cont(ys)));
+    zip_with_into(f, xs, ys, internal::get_back_inserter(zs));
+}
+
 // API search type: zip_with_3 : (((a, b, c) -> d), [a], [b], [c]) -> [c]
 // fwd bind count: 3
 // Zip three sequences using a ternary function.
@@ -145,6 +176,18 @@ auto zip(const ContainerIn1& xs, const ContainerIn2& ys)
     return zip_with(MakePair, xs, ys);
 }
 
+// API search type: zip_into : ([a], [b], [(a, b)]) -> ()
+// Same as zip, but writes the pairs into zs
+// (a container or an output iterator), like transform_into does.
+template <typename ContainerIn1, typename ContainerIn2, typename ContainerOut,
+    typename X = typename ContainerIn1::value_type,
+    typename Y = typename ContainerIn2::value_type>
+auto zip_into(const ContainerIn1& xs, const ContainerIn2& ys, ContainerOut&& zs)
+{
+    auto MakePair = [](const X& x, const Y& y) { return std::make_pair(x, y); };
+    return zip_with_into(MakePair, xs, ys, std::forward<ContainerOut>(zs));
+}
+
 // API search type: zip_repeat : ([a], [b]) -> [(a, b)]
 // fwd bind count: 1
 // Similar to zip but repeats the shorter sequence
@@ -9,8 +9,13 @@
 #include <fplus/maybe.hpp>
 #include <fplus/result.hpp>
 
+#include <fplus/internal/charconv.hpp>
+
+#include <cmath>
+#include <cstddef>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace fplus {
 
@@ -110,27 +115,101 @@ namespace internal {
             result = str;
         }
     };
+
+#if defined(__cpp_lib_to_chars)
+    template <typename T>
+    bool is_subnormal(std::true_type, T x)
+    {
+        return std::fpclassify(x) == FP_SUBNORMAL;
+    }
+
+    template <typename T>
+    bool is_subnormal(std::false_type, T)
+    {
+        return false;
+    }
+
+    // Parses the complete range without exceptions or locale.
+    // Subnormal values are out of range, like for the std::sto* functions.
+    template <typename T>
+    result<T, std::string> read_value_from_chars(std::true_type,
+        const char* first, const char* last)
+    {
+        T value;
+        const auto parsed = std::from_chars(first, last, value);
+        if (parsed.ec == std::errc::result_out_of_range
+            || (parsed.ec == std::errc()
+                && is_subnormal(std::is_floating_point<T>(), value))) {
+            return error<T, std::string>("Value out of range.");
+        }
+        if (parsed.ec != std::errc() || parsed.ptr != last) {
+            return error<T, std::string>("String not fully parsable.");
+        }
+        return ok<T, std::string>(value);
+    }
+#endif
+
+    template <typename T>
+    result<T, std::string> read_value_from_string(const std::string& str)
+    {
+        try {
+            T result;
+            std::size_t num_chars_used = 0;
+            internal::helper_read_value_struct<T>::read(str,
+                result, num_chars_used);
+            if (num_chars_used != str.size()) {
+                return error<T>(std::string("String not fully parsable."));
+            }
+            return ok<T, std::string>(result);
+        } catch (const std::invalid_argument& e) {
+            return error<T, std::string>(e.what());
+        } catch (const std::out_of_range& e) {
+            return error<T, std::string>(e.what());
+        }
+    }
+
+    template <typename T>
+    result<T, std::string> read_value_from_chars(std::false_type,
+        const char* first, const char* last)
+    {
+        return read_value_from_string<T>(std::string(first, last));
+    }
+
+    template <typename T>
+    result<T, std::string> read_value_result(std::true_type, const std::string& str)
+    {
+#if defined(__cpp_lib_to_chars)
+        // Only fall back to the std::sto* functions,
+        // which accept e.g. leading whitespace or a plus sign,
+        // for inputs std::from_chars does not fully accept.
+        const auto fast = read_value_from_chars<T>(std::true_type(),
+            str.data(), str.data() + str.size());
+        if (fplus::is_ok(fast)) {
+            return fast;
+        }
+#endif
+        return read_value_from_string<T>(str);
+    }
+
+    template <typename T>
+    result<T, std::string> read_value_result(std::false_type, const std::string& str)
+    {
+        return read_value_from_string<T>(str);
+    }
 }
 
 // API search type: read_value_result : String -> Result a
 // Try to deserialize a value.
+// Numbers are parsed like by the std::sto* functions,
+// e.g., leading whitespace and a plus sign are accepted.
+// If std::from_chars is available (C++17), it is tried first,
+// so then '.' is accepted as the decimal point
+// regardless of the global C locale.
 template <typename T>
 result<T, std::string> read_value_result(const std::string& str)
 {
-    try {
-        T result;
-        std::size_t num_chars_used = 0;
-        internal::helper_read_value_struct<T>::read(str,
-            result, num_chars_used);
-        if (num_chars_used != str.size()) {
-            return error<T>(std::string("String not fully parsable."));
-        }
-        return ok<T, std::string>(result);
-    } catch (const std::invalid_argument& e) {
-        return error<T, std::string>(e.what());
-    } catch (const std::out_of_range& e) {
-        return error<T, std::string>(e.what());
-    }
+    return internal::read_value_result<T>(
+        internal::is_chars_convertible<T>(), str);
 }
 
 // API search type: read_value : String -> Maybe a
@@ -178,4 +257,69 @@ T read_value_unsafe(const std::string& str)
     return unsafe_get_just(to_maybe(read_value_result<T>(str)));
 }
 
+// API search type: read_value_view_result : String -> Result a
+// Like read_value_result, but parses a view of characters,
+// e.g., a std::string_view, a span_view<const char> or a std::string,
+// without copying it into a std::string.
+// Numbers are parsed with std::from_chars if available (C++17),
+// which is locale-independent, does not throw on failure,
+// and does not accept leading whitespace or a plus sign.
+// Otherwise read_value_result is used.
+template <typename T, typename String>
+result<T, std::string> read_value_view_result(const String& str)
+{
+    const char* const first = str.data();
+    const char* const last = first + str.size();
+#if defined(__cpp_lib_to_chars)
+    return internal::read_value_from_chars<T>(
+        internal::is_chars_convertible<T>(), first, last);
+#else
+    return internal::read_value_from_chars<T>(std::false_type(), first, last);
+#endif
+}
+
+// API search type: read_value_view : String -> Maybe a
+// Like read_value, but parses a view of characters.
+// See read_value_view_result.
+// read_value_view<int>(string_view("42")) == 42
+template <typename T, typename String>
+maybe<T> read_value_view(const String& str)
+{
+    return to_maybe(read_value_view_result<T>(str));
+}
+
+// API search type: read_values_result : [String] -> Result [a]
+// Parses all given strings or views, e.g., the fields of a CSV column,
+// with read_value_view_result.
+// Stops at the first failure, reporting its index.
+// read_values_result<int>(["1", "2"]) == Ok [1, 2]
+// read_values_result<int>(["1", "x"]) == Error "1: String not fully parsable."
+template <typename T, typename ContainerIn>
+result<std::vector<T>, std::string> read_values_result(const ContainerIn& strs)
+{
+    std::vector<T> values;
+    values.reserve(strs.size());
+    std::size_t idx = 0;
+    for (const auto& str : strs) {
+        const auto value = read_value_view_result<T>(str);
+        if (is_error(value)) {
+            return error<std::vector<T>, std::string>(
+                std::to_string(idx) + ": " + value.unsafe_get_error());
+        }
+        values.push_back(value.unsafe_get_ok());
+        ++idx;
+    }
+    return ok<std::vector<T>, std::string>(std::move(values));
+}
+
+// API search type: read_values : [String] -> Maybe [a]
+// Parses all given strings or views, nothing if one of them fails.
+// See read_values_result.
+// read_values<int>(["1", "2"]) == Just [1, 2]
+template <typename T, typename ContainerIn>
+maybe<std::vector<T>> read_values(const ContainerIn& strs)
+{
+    return to_maybe(read_values_result<T>(strs));
+}
+
 } // namespace fplus
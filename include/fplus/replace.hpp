@@ -8,8 +8,15 @@
 
 #include <fplus/compare.hpp>
 #include <fplus/container_common.hpp>
+#include <fplus/search.hpp>
 #include <fplus/split.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
 namespace fplus {
 
 namespace internal {
@@ -110,4 +117,99 @@ Container replace_tokens(const Container& source, const Container& dest, const C
     return join(dest, splitted);
 }
 
+// Replaces segments matching tokens with their replacements
+// in a single pass over the input.
+// Where matches overlap, the one starting first wins,
+// and of the ones starting at the same position the longest.
+// Build it once to apply the same replacements to many inputs.
+//
+// Example usage:
+//
+// const token_replacer<std::string> replacer({{"&", "&amp;"}, {"<", "&lt;"}});
+// replacer(std::string("a<b&c")) == "a&lt;b&amp;c"
+template <typename Container>
+class token_replacer {
+public:
+    template <typename ContainerMapping>
+    explicit token_replacer(const ContainerMapping& mapping)
+        : automaton_(keys(mapping))
+        , replacements_(values(mapping))
+    {
+    }
+    token_replacer(std::initializer_list<std::pair<Container, Container>> mapping)
+        : token_replacer(std::vector<std::pair<Container, Container>>(mapping))
+    {
+    }
+    Container operator()(const Container& xs) const
+    {
+        auto matches = automaton_.find_all(xs);
+        // Longest match first for each position.
+        std::stable_sort(std::begin(matches), std::end(matches),
+            [this](const match& a, const match& b) {
+                return a.second < b.second
+                    || (a.second == b.second
+                        && automaton_.token_size(a.first) > automaton_.token_size(b.first));
+            });
+        Container result;
+        auto itOut = internal::get_back_inserter(result);
+        auto it = std::begin(xs);
+        std::size_t idx = 0;
+        for (const auto& m : matches) {
+            const std::size_t token_size = automaton_.token_size(m.first);
+            if (m.second < idx || token_size == 0) {
+                continue;
+            }
+            for (; idx < m.second; ++idx, ++it) {
+                *itOut = *it;
+            }
+            for (const auto& y : replacements_[m.first]) {
+                *itOut = y;
+            }
+            internal::advance_iterator(it, token_size);
+            idx += token_size;
+        }
+        std::copy(it, std::end(xs), itOut);
+        return result;
+    }
+
+private:
+    typedef typename token_automaton<Container>::match match;
+
+    template <typename ContainerMapping>
+    static std::vector<Container> keys(const ContainerMapping& mapping)
+    {
+        std::vector<Container> result;
+        for (const auto& p : mapping) {
+            result.push_back(p.first);
+        }
+        return result;
+    }
+    template <typename ContainerMapping>
+    static std::vector<Container> values(const ContainerMapping& mapping)
+    {
+        std::vector<Container> result;
+        for (const auto& p : mapping) {
+            result.push_back(p.second);
+        }
+        return result;
+    }
+
+    token_automaton<Container> automaton_;
+    std::vector<Container> replacements_;
+};
+
+// API search type: replace_tokens_multi : ([([a], [a])], [a]) -> [a]
+// fwd bind count: 1
+// Replaces all segments matching one of the tokens
+// with the corresponding replacement
+// in a single pass over the input, see token_replacer.
+// The mapping can be a std::map or a sequence of pairs.
+// replace_tokens_multi([("ha", "hi"), ("oh", "ah")], "oh, hahaha!")
+//     == "ah, hihihi!"
+template <typename ContainerMapping, typename Container>
+Container replace_tokens_multi(const ContainerMapping& mapping, const Container& xs)
+{
+    return token_replacer<Container>(mapping)(xs);
+}
+
 } // namespace fplus
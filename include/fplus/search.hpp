@@ -12,6 +12,17 @@
 #include <fplus/maybe.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace fplus {
 
@@ -128,10 +139,167 @@ ContainerOut find_all_idxs_of(const T& x, const Container& xs)
     return find_all_idxs_by(is_equal_to(x), xs);
 }
 
+namespace internal {
+
+    // Finds the first occurrence of a non-empty token in a range.
+    // Strings are scanned with char_traits::find (memchr for char)
+    // for the first token element before comparing the rest.
+    // Other random-access ranges of single-byte integers use
+    // Boyer-Moore-Horspool, with a shift table built once per token.
+    // Everything else falls back to std::search.
+    template <typename Container, typename Enable = void>
+    class token_finder {
+    public:
+        explicit token_finder(const Container& token)
+            : token_(token)
+        {
+        }
+        template <typename It>
+        It operator()(It first, It last) const
+        {
+            return std::search(first, last,
+                std::begin(token_), std::end(token_));
+        }
+
+    private:
+        const Container& token_;
+    };
+
+    template <typename C, typename Traits, typename Alloc>
+    class token_finder<std::basic_string<C, Traits, Alloc>> {
+    public:
+        explicit token_finder(const std::basic_string<C, Traits, Alloc>& token)
+            : token_(token)
+        {
+        }
+        template <typename It>
+        It operator()(It first, It last) const
+        {
+            const std::size_t m = token_.size();
+            const C* const begin = token_.data();
+            while (static_cast<std::size_t>(std::distance(first, last)) >= m) {
+                const std::size_t candidates = static_cast<std::size_t>(std::distance(first, last)) - m + 1;
+                const C* const p = &*first;
+                const C* const found = Traits::find(p, candidates, begin[0]);
+                if (found == nullptr) {
+                    return last;
+                }
+                std::advance(first, found - p);
+                if (Traits::compare(found + 1, begin + 1, m - 1) == 0) {
+                    return first;
+                }
+                ++first;
+            }
+            return last;
+        }
+
+    private:
+        const std::basic_string<C, Traits, Alloc>& token_;
+    };
+
+    template <typename T>
+    struct is_basic_string : std::false_type {
+    };
+
+    template <typename C, typename Traits, typename Alloc>
+    struct is_basic_string<std::basic_string<C, Traits, Alloc>>
+        : std::true_type {
+    };
+
+    template <typename Container>
+    using has_random_access_iterator = std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<
+            typename Container::const_iterator>::iterator_category>;
+
+    template <typename Container>
+    using is_horspool_searchable = std::integral_constant<bool,
+        !is_basic_string<Container>::value
+            && has_random_access_iterator<Container>::value
+            && std::is_integral<typename Container::value_type>::value
+            && !std::is_same<typename Container::value_type, bool>::value
+            && sizeof(typename Container::value_type) == 1>;
+
+    template <typename Container>
+    class token_finder<Container,
+        std::enable_if_t<is_horspool_searchable<Container>::value>> {
+    public:
+        explicit token_finder(const Container& token)
+            : token_(token)
+            , shifts_()
+        {
+            const std::size_t m = size_of_cont(token_);
+            shifts_.fill(m);
+            std::size_t i = 0;
+            for (auto it = std::begin(token_); i + 1 < m; ++it, ++i) {
+                shifts_[byte(*it)] = m - 1 - i;
+            }
+        }
+        template <typename It>
+        It operator()(It first, It last) const
+        {
+            const std::size_t m = size_of_cont(token_);
+            const auto token_begin = std::begin(token_);
+            const auto token_last = token_begin[static_cast<std::ptrdiff_t>(m - 1)];
+            if (m == 1) {
+                return std::find(first, last, token_last);
+            }
+            while (static_cast<std::size_t>(last - first) >= m) {
+                const auto x = first[static_cast<std::ptrdiff_t>(m - 1)];
+                if (x == token_last && std::equal(token_begin,
+                        token_begin + static_cast<std::ptrdiff_t>(m - 1), first)) {
+                    return first;
+                }
+                first += static_cast<std::ptrdiff_t>(shifts_[byte(x)]);
+            }
+            return last;
+        }
+
+    private:
+        template <typename T>
+        static std::size_t byte(T x)
+        {
+            return static_cast<unsigned char>(x);
+        }
+        const Container& token_;
+        std::array<std::size_t, 256> shifts_;
+    };
+
+#if defined(__cpp_lib_boyer_moore_searcher)
+    // Other hashable element types in random-access containers
+    // use the searcher of the standard library if available.
+    template <typename Container>
+    class token_finder<Container,
+        std::enable_if_t<!is_basic_string<Container>::value
+            && !is_horspool_searchable<Container>::value
+            && has_random_access_iterator<Container>::value
+            && is_hashable<typename Container::value_type>::value>> {
+    public:
+        explicit token_finder(const Container& token)
+            : searcher_(std::begin(token), std::end(token))
+        {
+        }
+        template <typename It>
+        It operator()(It first, It last) const
+        {
+            return std::search(first, last, searcher_);
+        }
+
+    private:
+        std::boyer_moore_horspool_searcher<
+            typename Container::const_iterator>
+            searcher_;
+    };
+#endif
+
+} // namespace internal
+
 // API search type: find_all_instances_of_token : ([a], [a]) -> [Int]
 // fwd bind count: 1
 // Returns the starting indices of all segments matching token.
 // find_all_instances_of_token("haha", "oh, hahaha!") == [4, 6]
+// Uses memchr-like scanning for strings
+// and Boyer-Moore-Horspool for random-access containers of bytes.
 template <typename ContainerOut = std::vector<std::size_t>, typename Container>
 ContainerOut find_all_instances_of_token(const Container& token,
     const Container& xs)
@@ -139,25 +307,29 @@ ContainerOut find_all_instances_of_token(const Container& token,
     if (size_of_cont(token) > size_of_cont(xs))
         return ContainerOut();
 
-    auto itInBegin = std::begin(xs);
-    auto itInEnd = itInBegin;
-    internal::advance_iterator(itInEnd, size_of_cont(token));
-    std::size_t idx = 0;
     ContainerOut result;
     auto outIt = internal::get_back_inserter(result);
-    std::size_t last_possible_idx = size_of_cont(xs) - size_of_cont(token);
-    auto check_and_push = [&]() {
-        if (std::equal(itInBegin, itInEnd, std::begin(token))) {
+    if (is_empty(token)) {
+        for (std::size_t idx = 0; idx <= size_of_cont(xs); ++idx) {
             *outIt = idx;
         }
-    };
-    while (idx != last_possible_idx) {
-        check_and_push();
-        ++itInBegin;
-        ++itInEnd;
+        return result;
+    }
+    const internal::token_finder<Container> find_token(token);
+    const auto itEnd = std::end(xs);
+    auto it = std::begin(xs);
+    std::size_t idx = 0;
+    for (;;) {
+        const auto itFound = find_token(it, itEnd);
+        if (itFound == itEnd) {
+            break;
+        }
+        idx += static_cast<std::size_t>(std::distance(it, itFound));
+        *outIt = idx;
+        it = itFound;
+        ++it;
         ++idx;
     }
-    check_and_push();
     return result;
 }
 
@@ -169,15 +341,29 @@ ContainerOut find_all_instances_of_token(const Container& token,
 template <typename ContainerOut = std::vector<std::size_t>, typename Container>
 ContainerOut find_all_instances_of_token_non_overlapping(const Container& token, const Container& xs)
 {
-    auto overlapping_instances = find_all_instances_of_token<ContainerOut>(
-        token, xs);
+    if (size_of_cont(token) > size_of_cont(xs))
+        return ContainerOut();
+
+    if (is_empty(token)) {
+        return find_all_instances_of_token<ContainerOut>(token, xs);
+    }
     ContainerOut result;
     auto outIt = internal::get_back_inserter(result);
-    std::size_t token_size = size_of_cont(token);
-    for (const auto idx : overlapping_instances) {
-        if (result.empty() || result.back() + token_size <= idx) {
-            *outIt = idx;
+    const std::size_t token_size = size_of_cont(token);
+    const internal::token_finder<Container> find_token(token);
+    const auto itEnd = std::end(xs);
+    auto it = std::begin(xs);
+    std::size_t idx = 0;
+    for (;;) {
+        const auto itFound = find_token(it, itEnd);
+        if (itFound == itEnd) {
+            break;
         }
+        idx += static_cast<std::size_t>(std::distance(it, itFound));
+        *outIt = idx;
+        it = itFound;
+        internal::advance_iterator(it, token_size);
+        idx += token_size;
     }
     return result;
 }
@@ -192,23 +378,188 @@ maybe<std::size_t> find_first_instance_of_token(const Container& token, const Co
     if (size_of_cont(token) > size_of_cont(xs))
         return nothing<std::size_t>();
 
-    auto itInBegin = std::begin(xs);
-    auto itInEnd = itInBegin;
-    internal::advance_iterator(itInEnd, size_of_cont(token));
-    std::size_t idx = 0;
-    std::size_t last_possible_idx = size_of_cont(xs) - size_of_cont(token);
-    while (idx != last_possible_idx) {
-        if (std::equal(itInBegin, itInEnd, std::begin(token))) {
-            return just(idx);
+    if (is_empty(token)) {
+        return just<std::size_t>(0);
+    }
+    const auto itBegin = std::begin(xs);
+    const auto itEnd = std::end(xs);
+    const auto itFound = internal::token_finder<Container>(token)(itBegin, itEnd);
+    if (itFound == itEnd) {
+        return nothing<std::size_t>();
+    }
+    return just(static_cast<std::size_t>(std::distance(itBegin, itFound)));
+}
+
+// A set of tokens compiled into an Aho-Corasick automaton,
+// so all of them can be searched for in a single pass over the input.
+// Building it takes time linear in the total token length.
+// The elements must be hashable or less-than comparable.
+// Empty tokens are ignored.
+// Reuse one instance to search different inputs for the same tokens.
+//
+// Example usage:
+//
+// const token_automaton<std::string> automaton({"he", "she", "hers"});
+// automaton.find_all(std::string("ushers"))
+//     == [(1, 1), (0, 2), (2, 2)]
+template <typename Container>
+class token_automaton {
+public:
+    typedef typename Container::value_type value_type;
+    typedef std::pair<std::size_t, std::size_t> match;
+
+    template <typename ContainerTokens>
+    explicit token_automaton(const ContainerTokens& tokens)
+        : nodes_(1)
+        , token_sizes_()
+    {
+        static_assert(std::is_same<Container,
+                          typename ContainerTokens::value_type>::value,
+            "Tokens must have the type of the container to search.");
+        for (const auto& token : tokens) {
+            add_token(token);
         }
-        ++itInBegin;
-        ++itInEnd;
-        ++idx;
+        link_nodes();
+    }
+    token_automaton(std::initializer_list<Container> tokens)
+        : token_automaton(std::vector<Container>(tokens))
+    {
     }
-    if (std::equal(itInBegin, itInEnd, std::begin(token))) {
-        return just(idx);
+
+    // Number of tokens, including empty ones.
+    std::size_t size() const
+    {
+        return token_sizes_.size();
     }
-    return nothing<std::size_t>();
+
+    // Returns (token index, position) pairs of all matches,
+    // including overlapping ones,
+    // ordered by position and then by token index.
+    std::vector<match> find_all(const Container& xs) const
+    {
+        std::vector<match> result;
+        std::size_t state = 0;
+        std::size_t end = 0;
+        for (const auto& x : xs) {
+            state = step(state, x);
+            ++end;
+            for (std::size_t n = state; n != 0; n = nodes_[n].output_link_) {
+                for (const auto token_idx : nodes_[n].tokens_) {
+                    result.push_back(match(
+                        token_idx, end - token_sizes_[token_idx]));
+                }
+            }
+        }
+        std::sort(std::begin(result), std::end(result),
+            [](const match& a, const match& b) {
+                return std::make_pair(a.second, a.first)
+                    < std::make_pair(b.second, b.first);
+            });
+        return result;
+    }
+
+    std::size_t token_size(std::size_t token_idx) const
+    {
+        return token_sizes_[token_idx];
+    }
+
+private:
+    typedef std::conditional_t<
+        internal::is_hashable<value_type>::value,
+        std::unordered_map<value_type, std::size_t>,
+        std::map<value_type, std::size_t>>
+        transitions;
+
+    struct node {
+        node()
+            : transitions_()
+            , fail_(0)
+            , output_link_(0)
+            , tokens_()
+        {
+        }
+        transitions transitions_;
+        // longest proper suffix also being a prefix of a token
+        std::size_t fail_;
+        // longest proper suffix being a complete token
+        std::size_t output_link_;
+        std::vector<std::size_t> tokens_;
+    };
+
+    void add_token(const Container& token)
+    {
+        const std::size_t token_idx = token_sizes_.size();
+        token_sizes_.push_back(size_of_cont(token));
+        if (is_empty(token)) {
+            return;
+        }
+        std::size_t n = 0;
+        for (const auto& x : token) {
+            const auto it = nodes_[n].transitions_.find(x);
+            if (it != std::end(nodes_[n].transitions_)) {
+                n = it->second;
+            } else {
+                nodes_.push_back(node());
+                nodes_[n].transitions_[x] = nodes_.size() - 1;
+                n = nodes_.size() - 1;
+            }
+        }
+        nodes_[n].tokens_.push_back(token_idx);
+    }
+
+    // Breadth-first, so the failure links of shorter prefixes
+    // are known when they are needed.
+    void link_nodes()
+    {
+        std::vector<std::size_t> queue;
+        for (const auto& t : nodes_[0].transitions_) {
+            queue.push_back(t.second);
+        }
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            const std::size_t n = queue[i];
+            for (const auto& t : nodes_[n].transitions_) {
+                const std::size_t child = t.second;
+                const std::size_t fail = step(nodes_[n].fail_, t.first);
+                nodes_[child].fail_ = fail;
+                nodes_[child].output_link_ = nodes_[fail].tokens_.empty()
+                    ? nodes_[fail].output_link_
+                    : fail;
+                queue.push_back(child);
+            }
+        }
+    }
+
+    std::size_t step(std::size_t n, const value_type& x) const
+    {
+        for (;;) {
+            const auto it = nodes_[n].transitions_.find(x);
+            if (it != std::end(nodes_[n].transitions_)) {
+                return it->second;
+            }
+            if (n == 0) {
+                return 0;
+            }
+            n = nodes_[n].fail_;
+        }
+    }
+
+    std::vector<node> nodes_;
+    std::vector<std::size_t> token_sizes_;
+};
+
+// API search type: find_all_instances_of_tokens : ([[a]], [a]) -> [(Int, Int)]
+// fwd bind count: 1
+// Returns (token index, starting index) pairs
+// of all segments matching one of the tokens,
+// ordered by starting index and then by token index.
+// Scans the input only once, see token_automaton.
+// find_all_instances_of_tokens(["ha", "oh"], "oh, haha!")
+//     == [(1, 0), (0, 4), (0, 6)]
+template <typename ContainerTokens, typename Container>
+std::vector<std::pair<std::size_t, std::size_t>> find_all_instances_of_tokens(
+    const ContainerTokens& tokens, const Container& xs)
+{
+    return token_automaton<Container>(tokens).find_all(xs);
 }
 
 } // namespace fplus
@@ -11,8 +11,14 @@
 #include <fplus/maybe.hpp>
 #include <fplus/transform.hpp>
 
+#include <fplus/internal/charconv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iomanip>
 #include <ios>
+#include <limits>
 #include <list>
 #include <sstream>
 #include <string>
@@ -20,6 +26,224 @@
 
 namespace fplus {
 
+namespace internal {
+#if defined(__cpp_lib_to_chars)
+    // Formats like streaming into a std::ostringstream with default flags,
+    // i.e., floating point values like printf's "%g".
+    template <typename T>
+    std::to_chars_result to_chars_like_stream(std::true_type,
+        char* first, char* last, const T& x)
+    {
+        return std::to_chars(first, last, x, std::chars_format::general, 6);
+    }
+
+    template <typename T>
+    std::to_chars_result to_chars_like_stream(std::false_type,
+        char* first, char* last, const T& x)
+    {
+        return std::to_chars(first, last, x);
+    }
+#endif
+
+    template <typename T>
+    void show_into(std::true_type, std::string& out, const T& x)
+    {
+#if defined(__cpp_lib_to_chars)
+        // Large enough for every integer and every "%g" representation.
+        char buffer[64];
+        const auto printed = to_chars_like_stream(
+            std::is_floating_point<T>(), buffer, buffer + sizeof(buffer), x);
+        out.append(buffer, printed.ptr);
+#else
+        out += std::to_string(x);
+#endif
+    }
+
+    template <typename T>
+    void show_into(std::false_type, std::string& out, const T& x)
+    {
+        std::ostringstream ss;
+        ss << x;
+        out += ss.str();
+    }
+
+    // std::to_string shows floating point values with six decimal places,
+    // unlike streams, so only integers can use it.
+    template <typename T>
+    using can_show_into_directly = std::integral_constant<bool,
+        is_chars_convertible<T>::value
+#if !defined(__cpp_lib_to_chars)
+            && std::is_integral<T>::value
+#endif
+        >;
+} // namespace internal
+
+// API search type: show_into : (String, a) -> ()
+// Appends the string representation of a value (see show)
+// to an existing string.
+// Avoids temporary strings when showing many values,
+// e.g., the elements of a container.
+// Integers and floating point values are formatted
+// with std::to_chars if available (C++17), without using a stream.
+template <typename T>
+void show_into(std::string& out, const T& x)
+{
+    internal::show_into(internal::can_show_into_directly<T>(), out, x);
+}
+
+// string identity
+inline void show_into(std::string& out, const std::string& str)
+{
+    out += str;
+}
+
+template <typename X, typename Y>
+void show_into(std::string& out, const std::pair<X, Y>& p);
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::vector<T, A>& xs);
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::list<T, A>& xs);
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::set<T, A>& xs);
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::deque<T, A>& xs);
+
+template <typename T>
+std::string show(const T& x);
+
+inline std::string show(const std::string& str);
+
+namespace internal {
+    // Numbers and strings are appended without a temporary string.
+    template <typename T>
+    void show_elem_into(std::true_type, std::string& out, const T& x)
+    {
+        fplus::show_into(out, x);
+    }
+
+    // Other values are shown unqualified,
+    // so overloads of show for user-defined types are found by ADL.
+    template <typename T>
+    void show_elem_into(std::false_type, std::string& out, const T& x)
+    {
+        using fplus::show;
+        out += show(x);
+    }
+
+    template <typename T>
+    void show_elem_into(std::string& out, const T& x)
+    {
+        show_elem_into(std::integral_constant<bool,
+                           std::is_arithmetic<T>::value
+                               || std::is_same<T, std::string>::value>(),
+            out, x);
+    }
+
+    // Lower bound of the length of show(x).
+    template <typename T>
+    std::size_t shown_size_hint(const T&)
+    {
+        return 1;
+    }
+
+    inline std::size_t shown_size_hint(const std::string& str)
+    {
+        return str.size();
+    }
+
+    // The frame and the separators are reserved up front,
+    // and strings are not regrown for elements with known sizes.
+    template <typename Container>
+    void reserve_for_show_cont(std::string& out,
+        const std::string& separator,
+        const std::string& prefix, const std::string& suffix,
+        const Container& xs,
+        std::size_t new_line_every_nth_elem)
+    {
+        std::size_t size = prefix.size() + suffix.size();
+        std::size_t n = 0;
+        for (const auto& x : xs) {
+            size += shown_size_hint(x);
+            ++n;
+        }
+        if (n > 1) {
+            size += (n - 1) * separator.size();
+            if (new_line_every_nth_elem != 0) {
+                size += (n - 1) / new_line_every_nth_elem * (prefix.size() + 1);
+            }
+        }
+        // Growing geometrically keeps appending to one buffer linear.
+        const std::size_t needed = out.size() + size;
+        if (needed > out.capacity()) {
+            out.reserve(std::max(needed, 2 * out.capacity()));
+        }
+    }
+
+    template <typename Container>
+    void show_cont_into(std::string& out,
+        const std::string& separator,
+        const std::string& prefix, const std::string& suffix,
+        const Container& xs,
+        std::size_t new_line_every_nth_elem)
+    {
+        reserve_for_show_cont(out, separator, prefix, suffix,
+            xs, new_line_every_nth_elem);
+        out += prefix;
+        std::size_t i = 0;
+        for (const auto& x : xs) {
+            if (i != 0) {
+                out += separator;
+                if (new_line_every_nth_elem != 0 && i % new_line_every_nth_elem == 0) {
+                    out += '\n';
+                    out.append(prefix.size(), ' ');
+                }
+            }
+            show_elem_into(out, x);
+            ++i;
+        }
+        out += suffix;
+    }
+} // namespace internal
+
+// {1, "one"} -> "(1, one)"
+template <typename X, typename Y>
+void show_into(std::string& out, const std::pair<X, Y>& p)
+{
+    out += '(';
+    internal::show_elem_into(out, p.first);
+    out += ", ";
+    internal::show_elem_into(out, p.second);
+    out += ')';
+}
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::vector<T, A>& xs)
+{
+    internal::show_cont_into(out, ", ", "[", "]", xs, 0);
+}
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::list<T, A>& xs)
+{
+    internal::show_cont_into(out, ", ", "[", "]", xs, 0);
+}
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::set<T, A>& xs)
+{
+    internal::show_cont_into(out, ", ", "[", "]", xs, 0);
+}
+
+template <typename T, typename A>
+void show_into(std::string& out, const std::deque<T, A>& xs)
+{
+    internal::show_cont_into(out, ", ", "[", "]", xs, 0);
+}
+
 // API search type: show : a -> String
 // fwd bind count: 0
 // 42 -> "42"
@@ -33,9 +257,9 @@ namespace fplus {
 template <typename T>
 std::string show(const T& x)
 {
-    std::ostringstream ss;
-    ss << x;
-    return ss.str();
+    std::string result;
+    show_into(result, x);
+    return result;
 }
 
 // string identity
@@ -45,44 +269,45 @@ inline std::string show(const std::string& str)
     return str;
 }
 
-template <typename T, typename A>
-std::string show(const std::vector<T, A>& xs);
-
-template <typename T, typename A>
-std::string show(const std::list<T, A>& xs);
-
 // {1, "one"} -> "(1, one)"
 template <typename X, typename Y>
 std::string show(const std::pair<X, Y>& p)
 {
-    return std::string("(") + show(p.first) + ", " + show(p.second) + ")";
+    std::string result;
+    show_into(result, p);
+    return result;
 }
 
-template <typename Container>
-std::string show_cont(const Container& xs);
-
 template <typename T, typename A>
 std::string show(const std::vector<T, A>& xs)
 {
-    return show_cont(xs);
+    std::string result;
+    show_into(result, xs);
+    return result;
 }
 
 template <typename T, typename A>
 std::string show(const std::list<T, A>& xs)
 {
-    return show_cont(xs);
+    std::string result;
+    show_into(result, xs);
+    return result;
 }
 
 template <typename T, typename A>
 std::string show(const std::set<T, A>& xs)
 {
-    return show_cont(xs);
+    std::string result;
+    show_into(result, xs);
+    return result;
 }
 
 template <typename T, typename A>
 std::string show(const std::deque<T, A>& xs)
 {
-    return show_cont(xs);
+    std::string result;
+    show_into(result, xs);
+    return result;
 }
 
 // API search type: show_cont_with_frame_and_newlines : (String, String, String, [a], Int) -> String
@@ -98,24 +323,10 @@ std::string show_cont_with_frame_and_newlines(
     const Container& xs,
     std::size_t new_line_every_nth_elem)
 {
-    std::vector<std::string> elemStrs;
-    elemStrs.reserve(xs.size());
-    if (new_line_every_nth_elem == 0) {
-        for (const auto& x : xs) {
-            elemStrs.push_back(show(x));
-        }
-    } else {
-        std::size_t i = 0;
-        std::string newline = std::string("\n") + std::string(prefix.size(), ' ');
-        for (const auto& x : xs) {
-            if (i && i % new_line_every_nth_elem == 0)
-                elemStrs.push_back(newline + show(x));
-            else
-                elemStrs.push_back(show(x));
-            ++i;
-        }
-    }
-    return prefix + join(separator, elemStrs) + suffix;
+    std::string result;
+    internal::show_cont_into(result, separator, prefix, suffix,
+        xs, new_line_every_nth_elem);
+    return result;
 }
 
 // API search type: show_cont_with_frame : (String, String, String, [a]) -> String
@@ -174,6 +385,37 @@ std::string show_result(const result<Ok, Error>& result)
         return std::string("Ok " + show(unsafe_get_ok(result)));
 }
 
+namespace internal {
+    template <typename T>
+    void show_fixed_into(std::false_type, std::string& out,
+        std::size_t right_char_count, const T& x)
+    {
+        std::stringstream stream;
+        stream
+            << std::fixed
+            << std::setprecision(static_cast<int>(right_char_count))
+            << x;
+        out += stream.str();
+    }
+
+    template <typename T>
+    void show_fixed_into(std::true_type, std::string& out,
+        std::size_t right_char_count, const T& x)
+    {
+#if defined(__cpp_lib_to_chars)
+        // Values too large for the buffer are streamed instead.
+        char buffer[128];
+        const auto printed = std::to_chars(buffer, buffer + sizeof(buffer), x,
+            std::chars_format::fixed, static_cast<int>(right_char_count));
+        if (printed.ec == std::errc()) {
+            out.append(buffer, printed.ptr);
+            return;
+        }
+#endif
+        show_fixed_into(std::false_type(), out, right_char_count, x);
+    }
+} // namespace internal
+
 // API search type: show_float : (Int, Int, Float) -> String
 // fwd bind count: 2
 // Can be used to show floating point values in a specific format
@@ -204,17 +446,19 @@ std::string show_float(
     std::size_t min_left_chars_final = is_negative && min_left_chars > 0
         ? min_left_chars - 1
         : min_left_chars;
-    std::stringstream stream;
-    stream
-        << std::fixed
-        << std::setprecision(static_cast<int>(right_char_count))
-        << std::abs(x);
-    std::string s = stream.str();
     std::size_t min_dest_length = min_left_chars_final + 1 + right_char_count;
-    std::string result = fill_left('0', min_dest_length, s);
+    std::string s;
+    internal::show_fixed_into(std::is_floating_point<T>(),
+        s, right_char_count, std::abs(x));
+    std::string result;
+    result.reserve(std::max(min_dest_length, s.size()) + 1);
     if (is_negative) {
-        result = std::string("-") + result;
+        result += '-';
+    }
+    if (s.size() < min_dest_length) {
+        result.append(min_dest_length - s.size(), '0');
     }
+    result += s;
     return result;
 }
 
@@ -236,6 +480,30 @@ std::string show_float_fill_left(const std::string::value_type& filler,
     return fill_left(filler, min_size, show_float<T>(0, right_char_count, x));
 }
 
+// API search type: show_round_trip : Float -> String
+// fwd bind count: 0
+// Shows a floating point value with as many digits as needed
+// to read it back to exactly the same value,
+// using the shortest such representation if std::to_chars is available (C++17).
+// show(0.1 + 0.2) == "0.3"
+// show_round_trip(0.1 + 0.2) == "0.30000000000000004"
+// show_round_trip(0.5) == "0.5"
+template <typename T>
+std::string show_round_trip(const T& x)
+{
+    static_assert(std::is_floating_point<T>::value,
+        "show_round_trip only supports floating point types.");
+#if defined(__cpp_lib_to_chars)
+    char buffer[64];
+    const auto printed = std::to_chars(buffer, buffer + sizeof(buffer), x);
+    return std::string(buffer, printed.ptr);
+#else
+    std::ostringstream ss;
+    ss << std::setprecision(std::numeric_limits<T>::max_digits10) << x;
+    return ss.str();
+#endif
+}
+
 // API search type: show_fill_left : (Char, Int, a) -> String
 // fwd bind count: 2
 // Convert some value to a string with left-padded with some character.
@@ -6,15 +6,21 @@
 
 #pragma once
 
+#include <fplus/cancellation_token.hpp>
 #include <fplus/container_common.hpp>
 #include <fplus/function_traits.hpp>
 #include <fplus/generate.hpp>
 #include <fplus/internal/invoke.hpp>
+#include <fplus/span_view.hpp>
 #include <fplus/string_tools.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdio>
 #include <cstdint>
 #include <fstream>
 #include <functional>
@@ -26,6 +32,12 @@
 #include <thread>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fplus {
 
 // Executes a function f in a fixed interval,
@@ -353,6 +365,35 @@ auto execute_parallelly_n_threads(std::size_t n, const Container& effs)
     };
 }
 
+// API search type: execute_parallelly_n_threads_cancellable : (CancellationToken, Int, [Io a]) -> Io (Result [a] String)
+// Returns a function that (when called) executes the given side effects
+// in parallel (n threads) and returns the collected results.
+// No further effects are started once the token is cancelled
+// or its deadline is exceeded. An error holding the reason is returned then.
+template <typename Container>
+auto execute_parallelly_n_threads_cancellable(const cancellation_token& token,
+    std::size_t n, const Container& effs)
+{
+    return [token, n, effs] {
+        return transform_parallelly_n_threads_cancellable(
+            token, n, [](const auto& eff) {
+                return internal::invoke(eff);
+            },
+            effs);
+    };
+}
+
+// API search type: execute_parallelly_cancellable : (CancellationToken, [Io a]) -> Io (Result [a] String)
+// Same as execute_parallelly_n_threads_cancellable,
+// but with one thread per effect.
+template <typename Container>
+auto execute_parallelly_cancellable(const cancellation_token& token,
+    const Container& effs)
+{
+    return execute_parallelly_n_threads_cancellable(
+        token, size_of_cont(effs), effs);
+}
+
 // API search type: execute_fire_and_forget : Io a -> Io a
 // Returns a function that (when called) executes the given side effect
 // in a new thread and returns immediately.
@@ -428,18 +469,223 @@ inline std::function<std::vector<std::uint8_t>()> read_binary_file(
     };
 }
 
+// Reads a text file line by line using a fixed-size buffer,
+// so the memory usage does not depend on the size of the file,
+// only on the length of the longest line.
+// "\n", "\r\n" and "\r" are line breaks,
+// also if a "\r\n" is split by the buffer boundary.
+// Like split_lines(true, content), every file has at least one line,
+// and a trailing line break is followed by an empty line.
+class line_reader {
+public:
+    explicit line_reader(const std::string& filename,
+        std::size_t buffer_size = 1 << 16)
+        : file_(filename, std::ios::binary)
+        , buffer_(std::max<std::size_t>(1, buffer_size))
+        , pos_(0)
+        , end_(0)
+        , skip_lf_(false)
+        , done_(!file_.good())
+    {
+    }
+    bool is_open() const
+    {
+        return file_.is_open();
+    }
+    // Stores the next line (without its line break) in line.
+    // Returns false if there are no more lines.
+    bool next(std::string& line)
+    {
+        line.clear();
+        if (done_) {
+            return false;
+        }
+        for (;;) {
+            if (pos_ == end_ && !fill()) {
+                done_ = true;
+                return true;
+            }
+            if (skip_lf_) {
+                skip_lf_ = false;
+                if (buffer_[pos_] == '\n') {
+                    ++pos_;
+                    continue;
+                }
+            }
+            const char* const first = buffer_.data() + pos_;
+            const char* const last = buffer_.data() + end_;
+            const char* const line_break = internal::find_line_break_char(first, last);
+            line.append(first, line_break);
+            if (line_break == last) {
+                pos_ = end_;
+                continue;
+            }
+            skip_lf_ = *line_break == '\r';
+            pos_ = static_cast<std::size_t>(line_break + 1 - buffer_.data());
+            return true;
+        }
+    }
+
+private:
+    bool fill()
+    {
+        file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        pos_ = 0;
+        end_ = static_cast<std::size_t>(file_.gcount());
+        return end_ != 0;
+    }
+    std::ifstream file_;
+    std::vector<char> buffer_;
+    std::size_t pos_;
+    std::size_t end_;
+    bool skip_lf_;
+    bool done_;
+};
+
+// A single-pass range over the lines of a text file, see line_reader.
+// Only the current line is kept in memory.
+// for (const auto& line : text_file_lines(false, "huge.log")) { ... }
+class text_file_line_range {
+public:
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::string value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string* pointer;
+        typedef const std::string& reference;
+
+        explicit iterator(text_file_line_range* range)
+            : range_(range)
+        {
+        }
+        reference operator*() const { return range_->line_; }
+        pointer operator->() const { return &range_->line_; }
+        iterator& operator++()
+        {
+            if (!range_->advance()) {
+                range_ = nullptr;
+            }
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator result = *this;
+            ++*this;
+            return result;
+        }
+        bool operator==(const iterator& other) const { return range_ == other.range_; }
+        bool operator!=(const iterator& other) const { return range_ != other.range_; }
+
+    private:
+        text_file_line_range* range_;
+    };
+
+    text_file_line_range(bool allow_empty, const std::string& filename,
+        std::size_t buffer_size = 1 << 16)
+        : reader_(filename, buffer_size)
+        , line_()
+        , allow_empty_(allow_empty)
+    {
+    }
+    bool is_open() const { return reader_.is_open(); }
+    // Can only be called once, since the lines are not stored.
+    iterator begin()
+    {
+        return iterator(advance() ? this : nullptr);
+    }
+    iterator end()
+    {
+        return iterator(nullptr);
+    }
+
+private:
+    bool advance()
+    {
+        while (reader_.next(line_)) {
+            if (allow_empty_ || !line_.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    line_reader reader_;
+    std::string line_;
+    bool allow_empty_;
+};
+
+// API search type: text_file_lines : (Bool, String) -> LineRange
+// Returns a lazy range over the lines of a text file,
+// which is read while iterating.
+// A file that can not be opened results in an empty range.
+inline text_file_line_range text_file_lines(bool allow_empty,
+    const std::string& filename)
+{
+    return text_file_line_range(allow_empty, filename);
+}
+
+// API search type: for_each_line : ((String -> ()), Bool, String) -> Io Bool
+// Returns a function that (when called) reads a text file
+// and passes its lines to f one by one, with constant memory usage.
+// The string passed to f is reused for the next line.
+// The function returns false if the file could not be opened.
+template <typename F>
+std::function<bool()> for_each_line(F f, bool allow_empty,
+    const std::string& filename)
+{
+    return [f, allow_empty, filename]() mutable -> bool {
+        line_reader reader(filename);
+        if (!reader.is_open())
+            return false;
+        std::string line;
+        while (reader.next(line)) {
+            if (allow_empty || !line.empty())
+                internal::invoke(f, static_cast<const std::string&>(line));
+        }
+        return true;
+    };
+}
+
+// API search type: fold_lines : (((a, String) -> a), a, Bool, String) -> Io (Maybe a)
+// Returns a function that (when called) folds over the lines of a text file
+// from left to right, with constant memory usage.
+// The function returns nothing if the file could not be opened.
+// fold_lines((acc, line) -> acc + size(line), 0, false, filename)
+// counts the non-line-break characters of a file.
+template <typename F, typename Acc>
+std::function<maybe<Acc>()> fold_lines(F f, const Acc& init,
+    bool allow_empty, const std::string& filename)
+{
+    return [f, init, allow_empty, filename]() mutable -> maybe<Acc> {
+        line_reader reader(filename);
+        if (!reader.is_open())
+            return {};
+        Acc acc = init;
+        std::string line;
+        while (reader.next(line)) {
+            if (allow_empty || !line.empty())
+                acc = internal::invoke(f, acc, static_cast<const std::string&>(line));
+        }
+        return acc;
+    };
+}
+
 // API search type: read_text_file_lines_maybe : (String, Bool) -> Io (Maybe [String])
 // Returns a function that (when called) reads the content of a text file
 // and returns it line by line.
+// The file is read in chunks, so its content is not held in memory twice.
 inline std::function<maybe<std::vector<std::string>>()> read_text_file_lines_maybe(
     bool allow_empty, const std::string& filename)
 {
     return [filename, allow_empty]() -> maybe<std::vector<std::string>> {
-        const auto maybe_content = read_text_file_maybe(filename)();
-        if (maybe_content.is_nothing())
+        std::vector<std::string> lines;
+        const bool success = for_each_line([&](const std::string& line) {
+            lines.push_back(line);
+        },
+            allow_empty, filename)();
+        if (!success)
             return {};
-        else
-            return split_lines(allow_empty, maybe_content.unsafe_get_just());
+        return lines;
     };
 }
 
@@ -460,10 +706,11 @@ inline std::function<std::vector<std::string>()> read_text_file_lines(
 // API search type: write_text_file : (String, String) -> Io Bool
 // Returns a function that (when called) writes content into a text file,
 // replacing it if it already exists.
+// Pass the content as an rvalue to avoid copying it.
 inline std::function<bool()> write_text_file(const std::string& filename,
-    const std::string& content)
+    std::string content)
 {
-    return [filename, content]() -> bool {
+    return [filename, content = std::move(content)]() -> bool {
         std::ofstream output(filename);
         output << content;
         return output.good();
@@ -473,12 +720,28 @@ inline std::function<bool()> write_text_file(const std::string& filename,
 // API search type: write_binary_file : (String, [Int]) -> Io Bool
 // Returns a function that (when called) writes content into a binary file,
 // replacing it if it already exists.
+// Pass the content as an rvalue to avoid copying it.
 inline std::function<bool()> write_binary_file(const std::string& filename,
-    const std::vector<uint8_t>& content)
+    std::vector<uint8_t> content)
+{
+    return [filename, content = std::move(content)]() -> bool {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(content.data()),
+            static_cast<std::streamsize>(content.size()));
+        return file.good();
+    };
+}
+
+// API search type: write_binary_file : (String, SpanView Int) -> Io Bool
+// Returns a function that (when called) writes the viewed bytes
+// into a binary file, replacing it if it already exists.
+// The bytes are not copied, so they must outlive the returned function.
+inline std::function<bool()> write_binary_file(const std::string& filename,
+    span_view<const std::uint8_t> content)
 {
     return [filename, content]() -> bool {
         std::ofstream file(filename, std::ios::binary);
-        file.write(reinterpret_cast<const char*>(&content[0]),
+        file.write(reinterpret_cast<const char*>(content.data()),
             static_cast<std::streamsize>(content.size()));
         return file.good();
     };
@@ -487,15 +750,246 @@ inline std::function<bool()> write_binary_file(const std::string& filename,
 // API search type: write_text_file_lines : (String, [String], Bool) -> Io Bool
 // Returns a function that (when called) writes lines into a text file,
 // replacing it if it already exists.
+// The lines are written one by one instead of being joined first.
 inline std::function<bool()> write_text_file_lines(bool trailing_newline,
     const std::string& filename,
-    const std::vector<std::string>& lines)
+    std::vector<std::string> lines)
 {
-    std::string content = join(std::string("\n"), lines);
-    if (trailing_newline) {
-        content += "\n";
+    return [trailing_newline, filename, lines = std::move(lines)]() -> bool {
+        std::ofstream output(filename);
+        bool is_first = true;
+        for (const auto& line : lines) {
+            if (!is_first) {
+                output << '\n';
+            }
+            output << line;
+            is_first = false;
+        }
+        if (trailing_newline) {
+            output << '\n';
+        }
+        return output.good();
+    };
+}
+
+namespace internal {
+    inline std::string temp_file_name(const std::string& filename)
+    {
+        static std::atomic<std::size_t> counter(0);
+        const auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+#if defined(__unix__) || defined(__APPLE__)
+        const std::string process = std::to_string(::getpid()) + "_";
+#else
+        const std::string process;
+#endif
+        return filename + ".tmp" + process + std::to_string(ticks) + "_" + std::to_string(counter++);
+    }
+
+    // Creates a new temporary file next to filename, failing instead of
+    // opening a file that already exists, e.g., one of another process.
+    // On POSIX it gets the permission bits of filename if that exists.
+    // The name of the file is stored in path.
+    inline std::FILE* create_temp_file(const std::string& filename,
+        std::string& path)
+    {
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            path = temp_file_name(filename);
+#if defined(__unix__) || defined(__APPLE__)
+            struct stat target;
+            const bool target_exists = ::stat(filename.c_str(), &target) == 0;
+            const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+            if (fd < 0) {
+                if (errno == EEXIST) {
+                    continue;
+                }
+                return nullptr;
+            }
+            // fchmod is not affected by the umask.
+            if (target_exists && ::fchmod(fd, target.st_mode & 07777) != 0) {
+                ::close(fd);
+                std::remove(path.c_str());
+                return nullptr;
+            }
+            std::FILE* const file = ::fdopen(fd, "wb");
+            if (file == nullptr) {
+                ::close(fd);
+                std::remove(path.c_str());
+            }
+            return file;
+#else
+            std::FILE* const file = std::fopen(path.c_str(), "wbx");
+            if (file != nullptr) {
+                return file;
+            }
+#endif
+        }
+        return nullptr;
+    }
+} // namespace internal
+
+// Writes chunks of bytes into a file through a large buffer,
+// without any line break conversion.
+// In atomic mode the data is written to a new temporary file next to the target,
+// which keeps the permissions of the target (POSIX only)
+// and only replaces it when close() succeeds,
+// so readers never see a partially written file.
+// Destroying an atomic writer without closing it discards the written data.
+// With sync, the data is flushed to the storage device (fsync)
+// before the file is closed (POSIX only).
+class file_writer {
+public:
+    explicit file_writer(const std::string& filename,
+        bool atomic = false, bool sync = false,
+        std::size_t buffer_size = 1 << 20)
+        : filename_(filename)
+        , path_(filename)
+        , atomic_(atomic)
+        , sync_(sync)
+        , buffer_(std::max<std::size_t>(1, buffer_size))
+        , file_(atomic ? internal::create_temp_file(filename, path_)
+                       : std::fopen(path_.c_str(), "wb"))
+        , good_(file_ != nullptr)
+        , closed_successfully_(false)
+    {
+        if (file_ != nullptr) {
+            std::setvbuf(file_, buffer_.data(), _IOFBF, buffer_.size());
+        }
+    }
+    file_writer(const file_writer&) = delete;
+    file_writer& operator=(const file_writer&) = delete;
+    ~file_writer()
+    {
+        if (file_ == nullptr) {
+            return;
+        }
+        if (atomic_) {
+            std::fclose(file_);
+            std::remove(path_.c_str());
+        } else {
+            close();
+        }
+    }
+    // False if the file could not be opened, a write failed
+    // or the writer was closed already.
+    bool good() const
+    {
+        return good_ && file_ != nullptr;
+    }
+    bool write(const char* data, std::size_t size)
+    {
+        if (!good()) {
+            return false;
+        }
+        if (size != 0) {
+            good_ = std::fwrite(data, 1, size, file_) == size;
+        }
+        return good_;
+    }
+    // Writes a std::string, std::vector<char>, span_view<const char> etc.
+    template <typename Chunk>
+    bool write(const Chunk& chunk)
+    {
+        return write(reinterpret_cast<const char*>(chunk.data()),
+            chunk.size() * sizeof(*chunk.data()));
+    }
+    bool put(char c)
+    {
+        return write(&c, 1);
     }
-    return write_text_file(filename, content);
+    // Flushes and closes the file, and in atomic mode replaces the target.
+    // Returns true if everything was written successfully.
+    // Further calls return the same result without doing anything.
+    bool close()
+    {
+        if (file_ == nullptr) {
+            return closed_successfully_;
+        }
+        good_ = std::fflush(file_) == 0 && good_;
+#if defined(__unix__) || defined(__APPLE__)
+        if (sync_ && good_) {
+            good_ = ::fsync(::fileno(file_)) == 0;
+        }
+#endif
+        good_ = std::fclose(file_) == 0 && good_;
+        file_ = nullptr;
+        if (atomic_) {
+            if (good_ && std::rename(path_.c_str(), filename_.c_str()) != 0) {
+                // Renaming onto an existing file fails on Windows.
+                std::remove(filename_.c_str());
+                good_ = std::rename(path_.c_str(), filename_.c_str()) == 0;
+            }
+            if (!good_) {
+                std::remove(path_.c_str());
+            }
+        }
+        closed_successfully_ = good_;
+        return closed_successfully_;
+    }
+
+private:
+    std::string filename_;
+    std::string path_;
+    bool atomic_;
+    bool sync_;
+    std::vector<char> buffer_;
+    std::FILE* file_;
+    bool good_;
+    bool closed_successfully_;
+};
+
+// API search type: write_text_file_chunks : (String, [String]) -> Io Bool
+// Returns a function that (when called) writes the given chunks,
+// e.g., strings or views, one after another into a file
+// through a large buffer, without joining them first
+// and without line break conversion.
+// Pass the chunks as an rvalue to avoid copying them.
+template <typename Container>
+std::function<bool()> write_text_file_chunks(const std::string& filename,
+    Container chunks)
+{
+    return [filename, chunks = std::move(chunks)]() -> bool {
+        file_writer writer(filename);
+        for (const auto& chunk : chunks) {
+            writer.write(chunk);
+        }
+        return writer.close();
+    };
+}
+
+// API search type: write_text_file_generated : (String, Io (Maybe String)) -> Io Bool
+// Returns a function that (when called) calls the generator
+// and writes the chunks it returns into a file, until it returns nothing.
+// Only one chunk is held in memory at a time.
+template <typename Generator>
+std::function<bool()> write_text_file_generated(const std::string& filename,
+    Generator gen)
+{
+    return [filename, gen]() mutable -> bool {
+        file_writer writer(filename);
+        for (;;) {
+            const auto chunk = internal::invoke(gen);
+            if (is_nothing(chunk)) {
+                break;
+            }
+            writer.write(chunk.unsafe_get_just());
+        }
+        return writer.close();
+    };
+}
+
+// API search type: write_text_file_atomic : (Bool, String, String) -> Io Bool
+// Returns a function that (when called) replaces the content of a file
+// atomically, i.e., readers either see the old or the complete new content.
+// With sync, the data is flushed to the storage device before the
+// file is replaced. No line break conversion is done.
+inline std::function<bool()> write_text_file_atomic(bool sync,
+    const std::string& filename, std::string content)
+{
+    return [sync, filename, content = std::move(content)]() -> bool {
+        file_writer writer(filename, true, sync);
+        writer.write(content);
+        return writer.close();
+    };
 }
 
 // API search type: execute_effect : Io a -> a
@@ -524,6 +1018,130 @@ std::function<void()> interact(F f)
     };
 }
 
+namespace internal {
+    // Flushing only when no more input is buffered
+    // gives a low latency for interactive input,
+    // without flushing after every line of a fast input.
+    inline void flush_if_no_input_buffered()
+    {
+        if (std::cin.rdbuf()->in_avail() <= 0) {
+            std::cout.flush();
+        }
+    }
+
+    // Unties std::cin from std::cout while it exists,
+    // also if the function processing the input throws.
+    class cin_untie_guard {
+    public:
+        cin_untie_guard()
+            : tied_(std::cin.tie(nullptr))
+        {
+        }
+        cin_untie_guard(const cin_untie_guard&) = delete;
+        cin_untie_guard& operator=(const cin_untie_guard&) = delete;
+        ~cin_untie_guard()
+        {
+            std::cin.tie(tied_);
+        }
+
+    private:
+        std::ostream* tied_;
+    };
+
+    // Reads the input that is buffered already, up to size characters.
+    // If the stream buffer does not tell, e.g., because std::cin is
+    // synchronized with C stdio, reads up to the end of the next line
+    // instead of single characters, so the latency stays low
+    // for interactive input, which arrives line by line.
+    // Returns 0 at the end of the input.
+    inline std::streamsize read_available_chunk(std::streambuf& input,
+        char* buffer, std::streamsize size)
+    {
+        typedef std::char_traits<char> traits;
+        // sgetc blocks until input is available.
+        if (input.sgetc() == traits::eof()) {
+            return 0;
+        }
+        const std::streamsize available = input.in_avail();
+        if (available > 0) {
+            return input.sgetn(buffer, std::min(size, available));
+        }
+        std::streamsize count = 0;
+        while (count < size) {
+            const auto c = input.sbumpc();
+            if (c == traits::eof()) {
+                break;
+            }
+            buffer[count++] = traits::to_char_type(c);
+            if (c == '\n') {
+                break;
+            }
+        }
+        return count;
+    }
+} // namespace internal
+
+// API search type: interact_by_line : (String -> String) -> Io ()
+// Like interact, but reads standard input line by line,
+// passing each line (without its "\n" or "\r\n") to the given function
+// and writing the result followed by "\n" to standard output.
+// The memory usage does not depend on the size of the input,
+// so unbounded streams can be processed.
+// Output is flushed whenever no more input is buffered.
+// For the highest throughput, call std::ios_base::sync_with_stdio(false)
+// before the first I/O operation of the program.
+template <typename F>
+std::function<void()> interact_by_line(F f)
+{
+    return [f]() mutable -> void {
+        const internal::cin_untie_guard untie;
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::cout << internal::invoke(f, static_cast<const std::string&>(line)) << '\n';
+            internal::flush_if_no_input_buffered();
+        }
+        std::cout.flush();
+    };
+}
+
+// API search type: interact_by_chunk : (String -> String) -> Io ()
+// Like interact, but passes standard input to the given function
+// in chunks of at most 64 KiB, as soon as they are available,
+// and writes the results to standard output.
+// Chunks can end anywhere, even in the middle of a line,
+// so this is meant for functions working on single characters,
+// e.g., to_upper_case.
+// While std::cin is synchronized with C stdio (the default),
+// its buffer can not be inspected, so a chunk then ends
+// at the next line break at the latest.
+// Output is flushed whenever no more input is buffered.
+// For the highest throughput, call std::ios_base::sync_with_stdio(false)
+// before the first I/O operation of the program.
+template <typename F>
+std::function<void()> interact_by_chunk(F f)
+{
+    return [f]() mutable -> void {
+        const internal::cin_untie_guard untie;
+        const std::streamsize max_chunk_size = 1 << 16;
+        std::vector<char> buffer(static_cast<std::size_t>(max_chunk_size));
+        std::string chunk;
+        for (;;) {
+            const std::streamsize size = internal::read_available_chunk(
+                *std::cin.rdbuf(), buffer.data(), max_chunk_size);
+            if (size == 0) {
+                break;
+            }
+            chunk.assign(buffer.data(), static_cast<std::size_t>(size));
+            std::cout << internal::invoke(f, static_cast<const std::string&>(chunk));
+            internal::flush_if_no_input_buffered();
+        }
+        std::cout.flush();
+    };
+}
+
 // API search type: execute_with_maybe : ((a -> void), Maybe a) -> Io Bool
 // Returns a function that
 // akes a unary side-effect function with
@@ -0,0 +1,437 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace fplus {
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#endif
+
+// A sequence container like std::vector,
+// which stores up to N elements inside of the object itself,
+// i.e., without allocating memory on the heap.
+// Only if more elements are added, they are moved to the heap.
+// Can be used as ContainerOut of functions with short results, e.g.:
+// transform_convert<small_vector<int, 4>>(f, xs)
+// Functions taking a small_vector return small_vectors with the same N.
+template <typename T, std::size_t N>
+class small_vector {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    small_vector()
+        : data_(inline_data())
+        , size_(0)
+        , capacity_(N)
+    {
+    }
+    explicit small_vector(std::size_t n)
+        : small_vector()
+    {
+        resize(n);
+    }
+    small_vector(std::size_t n, const T& value)
+        : small_vector()
+    {
+        assign(n, value);
+    }
+    template <typename InputIt,
+        typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    small_vector(InputIt first, InputIt last)
+        : small_vector()
+    {
+        assign(first, last);
+    }
+    small_vector(std::initializer_list<T> xs)
+        : small_vector()
+    {
+        assign(xs.begin(), xs.end());
+    }
+    small_vector(const small_vector& other)
+        : small_vector()
+    {
+        assign(other.begin(), other.end());
+    }
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : small_vector()
+    {
+        take(std::move(other));
+    }
+    ~small_vector()
+    {
+        clear();
+        deallocate();
+    }
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other) {
+            clear();
+            take(std::move(other));
+        }
+        return *this;
+    }
+    small_vector& operator=(std::initializer_list<T> xs)
+    {
+        assign(xs.begin(), xs.end());
+        return *this;
+    }
+
+    void assign(std::size_t n, const T& value)
+    {
+        clear();
+        reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            push_back(value);
+        }
+    }
+    template <typename InputIt,
+        typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    void assign(InputIt first, InputIt last)
+    {
+        clear();
+        reserve_for(first, last,
+            typename std::iterator_traits<InputIt>::iterator_category());
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // Elements are stored inline as long as the size does not exceed N.
+    bool is_inline() const { return data_ == inline_data(); }
+    static constexpr std::size_t inline_capacity() { return N; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t max_size() const { return std::allocator_traits<std::allocator<T>>::max_size(std::allocator<T>()); }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    T& operator[](std::size_t idx)
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+    const T& operator[](std::size_t idx) const
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+    T& at(std::size_t idx)
+    {
+        check_index(idx);
+        return data_[idx];
+    }
+    const T& at(std::size_t idx) const
+    {
+        check_index(idx);
+        return data_[idx];
+    }
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    void reserve(std::size_t new_capacity)
+    {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        T* const new_data = std::allocator<T>().allocate(new_capacity);
+        // If an element can not be copied, the old ones are left untouched.
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < size_; ++constructed) {
+                ::new (static_cast<void*>(new_data + constructed))
+                    T(std::move_if_noexcept(data_[constructed]));
+            }
+        } catch (...) {
+            for (std::size_t i = 0; i < constructed; ++i) {
+                new_data[i].~T();
+            }
+            std::allocator<T>().deallocate(new_data, new_capacity);
+            throw;
+        }
+        for (std::size_t i = 0; i < size_; ++i) {
+            data_[i].~T();
+        }
+        deallocate();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+    void push_back(const T& x) { emplace_back(x); }
+    void push_back(T&& x) { emplace_back(std::move(x)); }
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (size_ == capacity_) {
+            // The argument could refer to an element, which is moved by growing.
+            T x(std::forward<Args>(args)...);
+            reserve(grown_capacity(size_ + 1));
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(x));
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+    void pop_back()
+    {
+        assert(size_ > 0);
+        data_[--size_].~T();
+    }
+    void clear()
+    {
+        while (size_ > 0) {
+            pop_back();
+        }
+    }
+    void resize(std::size_t n)
+    {
+        shrink_size(n);
+        reserve(n);
+        while (size_ < n) {
+            emplace_back();
+        }
+    }
+    void resize(std::size_t n, const T& value)
+    {
+        shrink_size(n);
+        reserve(n);
+        while (size_ < n) {
+            push_back(value);
+        }
+    }
+
+    iterator insert(const_iterator pos, const T& x)
+    {
+        return insert(pos, std::size_t(1), x);
+    }
+    iterator insert(const_iterator pos, T&& x)
+    {
+        const auto idx = index_of(pos);
+        emplace_back(std::move(x));
+        std::rotate(begin() + idx, end() - 1, end());
+        return begin() + idx;
+    }
+    iterator insert(const_iterator pos, std::size_t n, const T& x)
+    {
+        const auto idx = index_of(pos);
+        const T value = x;
+        if (size_ + n > capacity_) {
+            reserve(grown_capacity(size_ + n));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            push_back(value);
+        }
+        std::rotate(begin() + idx, end() - static_cast<std::ptrdiff_t>(n), end());
+        return begin() + idx;
+    }
+    template <typename InputIt,
+        typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const auto idx = index_of(pos);
+        const std::size_t old_size = size_;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + idx, begin() + static_cast<std::ptrdiff_t>(old_size), end());
+        return begin() + idx;
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> xs)
+    {
+        return insert(pos, xs.begin(), xs.end());
+    }
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const auto idx = index_of(pos);
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + idx, end() - 1, end());
+        return begin() + idx;
+    }
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto idx = index_of(first);
+        const auto n = static_cast<std::size_t>(last - first);
+        std::move(begin() + idx + static_cast<std::ptrdiff_t>(n), end(), begin() + idx);
+        shrink_size(size_ - n);
+        return begin() + idx;
+    }
+
+    void swap(small_vector& other)
+    {
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    T* inline_data()
+    {
+        return reinterpret_cast<T*>(inline_);
+    }
+    const T* inline_data() const
+    {
+        return reinterpret_cast<const T*>(inline_);
+    }
+    void deallocate()
+    {
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+    // Expects this to be empty.
+    void take(small_vector&& other)
+    {
+        if (other.is_inline()) {
+            reserve(other.size_);
+            for (auto& x : other) {
+                emplace_back(std::move(x));
+            }
+            other.clear();
+        } else {
+            deallocate();
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+    void shrink_size(std::size_t n)
+    {
+        while (size_ > n) {
+            pop_back();
+        }
+    }
+    std::size_t grown_capacity(std::size_t min_capacity) const
+    {
+        return std::max(min_capacity, 2 * capacity_);
+    }
+    std::ptrdiff_t index_of(const_iterator pos) const
+    {
+        return pos - begin();
+    }
+    void check_index(std::size_t idx) const
+    {
+        if (idx >= size_) {
+            throw std::out_of_range("small_vector index out of range");
+        }
+    }
+    template <typename InputIt>
+    void reserve_for(InputIt first, InputIt last, std::forward_iterator_tag)
+    {
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+    }
+    template <typename InputIt>
+    void reserve_for(InputIt, InputIt, std::input_iterator_tag)
+    {
+    }
+
+    T* data_;
+    std::size_t size_;
+    std::size_t capacity_;
+    // Not initialized, elements are constructed in place when added.
+    alignas(T) unsigned char inline_[sizeof(T) * (N == 0 ? 1 : N)];
+};
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+template <typename T, std::size_t N>
+bool operator==(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return xs.size() == ys.size() && std::equal(xs.begin(), xs.end(), ys.begin());
+}
+
+template <typename T, std::size_t N>
+bool operator!=(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return !(xs == ys);
+}
+
+template <typename T, std::size_t N>
+bool operator<(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return std::lexicographical_compare(xs.begin(), xs.end(), ys.begin(), ys.end());
+}
+
+template <typename T, std::size_t N>
+bool operator>(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return ys < xs;
+}
+
+template <typename T, std::size_t N>
+bool operator<=(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return !(ys < xs);
+}
+
+template <typename T, std::size_t N>
+bool operator>=(const small_vector<T, N>& xs, const small_vector<T, N>& ys)
+{
+    return !(xs < ys);
+}
+
+template <typename T, std::size_t N>
+void swap(small_vector<T, N>& xs, small_vector<T, N>& ys)
+{
+    xs.swap(ys);
+}
+
+} // namespace fplus
@@ -0,0 +1,410 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <fplus/compare.hpp>
+#include <fplus/container_common.hpp>
+#include <fplus/internal/invoke.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace fplus {
+
+// A non-owning view of contiguous elements,
+// e.g., a part of a std::vector, std::array or std::string.
+// The viewed container must outlive the view
+// and must not be reallocated while the view is in use.
+// Views can be passed to all algorithms only reading their input
+// or creating containers of a new element type (e.g., transform),
+// which then return a std::vector.
+// To use algorithms returning a container of the same type (e.g., keep_if)
+// convert the view first, e.g., with convert_container<std::vector<T>>.
+template <typename T>
+class span_view {
+public:
+    typedef std::remove_cv_t<T> value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    span_view()
+        : data_(nullptr)
+        , size_(0)
+    {
+    }
+    span_view(T* data, std::size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+    // Views of mutable elements can be used as views of const elements.
+    template <typename U,
+        typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    span_view(const span_view<U>& other)
+        : data_(other.data())
+        , size_(other.size())
+    {
+    }
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T& operator[](std::size_t idx) const
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+    T& front() const { return (*this)[0]; }
+    T& back() const { return (*this)[size_ - 1]; }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
+
+template <typename T, typename U>
+bool operator==(const span_view<T>& xs, const span_view<U>& ys)
+{
+    return xs.size() == ys.size()
+        && std::equal(std::begin(xs), std::end(xs), std::begin(ys));
+}
+
+template <typename T, typename U>
+bool operator!=(const span_view<T>& xs, const span_view<U>& ys)
+{
+    return !(xs == ys);
+}
+
+namespace internal {
+
+    template <typename Container>
+    using span_view_elem_t = std::remove_pointer_t<
+        decltype(std::declval<Container&>().data())>;
+
+    // Type of the views into a container returned by the _view(s) functions.
+    // Strings are viewed as std::basic_string_view if available.
+    template <typename Container>
+    struct view {
+        typedef span_view<span_view_elem_t<const Container>> type;
+    };
+
+#if defined(__cpp_lib_string_view)
+    template <typename C, typename Traits, typename Alloc>
+    struct view<std::basic_string<C, Traits, Alloc>> {
+        typedef std::basic_string_view<C, Traits> type;
+    };
+
+    template <typename C, typename Traits>
+    struct view<std::basic_string_view<C, Traits>> {
+        typedef std::basic_string_view<C, Traits> type;
+    };
+#endif
+
+    template <typename Container>
+    using view_t = typename view<Container>::type;
+
+    // Calls visit(idx_begin, idx_end) for every piece
+    // between the separators found by find_separator(idx),
+    // which returns the position and the length of the next separator
+    // (position size if there is none),
+    // with the same treatment of empty pieces as split_by.
+    template <typename FindSeparator, typename Visit>
+    void visit_split_pieces(FindSeparator find_separator,
+        bool allow_empty, std::size_t size, Visit visit)
+    {
+        if (allow_empty && size == 0) {
+            visit(std::size_t(0), std::size_t(0));
+            return;
+        }
+        std::size_t start = 0;
+        while (start != size) {
+            const auto separator = find_separator(start);
+            const std::size_t stop = separator.first;
+            if (start != stop || allow_empty) {
+                visit(start, stop);
+            }
+            if (stop == size) {
+                break;
+            }
+            start = stop + separator.second;
+            if (allow_empty && start == size) {
+                visit(size, size);
+            }
+        }
+    }
+
+    // Line breaks: "\n", "\r\n" or "\r".
+    template <typename T>
+    std::pair<std::size_t, std::size_t> find_line_break(
+        const T* data, std::size_t size, std::size_t start)
+    {
+        for (std::size_t idx = start; idx < size; ++idx) {
+            if (data[idx] == '\n') {
+                return { idx, 1 };
+            }
+            if (data[idx] == '\r') {
+                const bool crlf = idx + 1 < size && data[idx + 1] == '\n';
+                return { idx, crlf ? 2 : 1 };
+            }
+        }
+        return { size, 0 };
+    }
+
+    // First "\n" or "\r" in [first, last), last if there is none.
+    // memchr, which std::char_traits<char>::find uses,
+    // is vectorized in the common C libraries.
+    // Both characters are searched window by window,
+    // so the time is linear in the distance to the line break,
+    // also if the text only uses "\r".
+    inline const char* find_line_break_char(const char* first, const char* last)
+    {
+        const std::size_t window_size = 1024;
+        while (first != last) {
+            const std::size_t size = std::min(window_size,
+                static_cast<std::size_t>(last - first));
+            const char* const lf = std::char_traits<char>::find(first, size, '\n');
+            const std::size_t lf_idx = lf == nullptr
+                ? size
+                : static_cast<std::size_t>(lf - first);
+            const char* const cr = std::char_traits<char>::find(first, lf_idx, '\r');
+            if (cr != nullptr) {
+                return cr;
+            }
+            if (lf != nullptr) {
+                return lf;
+            }
+            first += size;
+        }
+        return last;
+    }
+
+    inline std::pair<std::size_t, std::size_t> find_line_break(
+        const char* data, std::size_t size, std::size_t start)
+    {
+        const char* const it = find_line_break_char(data + start, data + size);
+        const auto idx = static_cast<std::size_t>(it - data);
+        if (idx == size) {
+            return { size, 0 };
+        }
+        const bool crlf = *it == '\r' && idx + 1 < size && data[idx + 1] == '\n';
+        return { idx, crlf ? 2 : 1 };
+    }
+
+} // namespace internal
+
+// API search type: make_span_view : [a] -> SpanView a
+// fwd bind count: 0
+// Creates a view of all elements of a contiguous container,
+// i.e., a std::vector, std::array, std::string or span_view.
+template <typename Container>
+span_view<internal::span_view_elem_t<Container>> make_span_view(Container& xs)
+{
+    return { xs.data(), xs.size() };
+}
+
+// API search type: get_segment_view : (Int, Int, [a]) -> SpanView a
+// fwd bind count: 2
+// Like get_segment, but returns a view instead of a copy.
+// get_segment_view(2, 5, [0,1,2,3,4,5,6,7,8]) == [2,3,4]
+// get_segment_view(2, 15, [0,1,2,3,4,5,6,7,8]) == [2,3,4,5,6,7,8]
+// get_segment_view(5, 2, [0,1,2,3,4,5,6,7,8]) == []
+// O(1)
+template <typename Container>
+internal::view_t<Container> get_segment_view(
+    std::size_t idx_begin, std::size_t idx_end, const Container& xs)
+{
+    idx_end = std::min(idx_end, size_of_cont(xs));
+    if (idx_end <= idx_begin) {
+        return { xs.data() + size_of_cont(xs), 0 };
+    }
+    return { xs.data() + idx_begin, idx_end - idx_begin };
+}
+
+// API search type: take_view : (Int, [a]) -> SpanView a
+// fwd bind count: 1
+// Like take, but returns a view instead of a copy.
+// take_view(3, [0,1,2,3,4,5,6,7]) == [0,1,2]
+template <typename Container>
+internal::view_t<Container> take_view(
+    std::size_t amount, const Container& xs)
+{
+    return get_segment_view(0, amount, xs);
+}
+
+// API search type: drop_view : (Int, [a]) -> SpanView a
+// fwd bind count: 1
+// Like drop, but returns a view instead of a copy.
+// drop_view(3, [0,1,2,3,4,5,6,7]) == [3,4,5,6,7]
+template <typename Container>
+internal::view_t<Container> drop_view(
+    std::size_t amount, const Container& xs)
+{
+    return get_segment_view(amount, size_of_cont(xs), xs);
+}
+
+// API search type: split_every_views : (Int, [a]) -> [SpanView a]
+// fwd bind count: 1
+// Like split_every, but returns views instead of copies.
+// split_every_views(3, [0,1,2,3,4,5,6,7]) == [[0,1,2],[3,4,5],[6,7]]
+template <typename Container>
+std::vector<internal::view_t<Container>>
+split_every_views(std::size_t n, const Container& xs)
+{
+    assert(n > 0);
+    std::vector<internal::view_t<Container>> result;
+    result.reserve(size_of_cont(xs) / n + 1);
+    for (std::size_t idx = 0; idx < size_of_cont(xs); idx += n) {
+        result.push_back(get_segment_view(idx, idx + n, xs));
+    }
+    return result;
+}
+
+// API search type: aperture_views : (Int, [a]) -> [SpanView a]
+// fwd bind count: 1
+// Like aperture, but returns views instead of copies,
+// so it needs O(n) instead of O(n*length) memory.
+// aperture_views(5, [0,1,2,3,4,5,6]) == [[0,1,2,3,4],[1,2,3,4,5],[2,3,4,5,6]]
+template <typename Container>
+std::vector<internal::view_t<Container>>
+aperture_views(std::size_t length, const Container& xs)
+{
+    assert(length > 0);
+    std::vector<internal::view_t<Container>> result;
+    if (size_of_cont(xs) < length) {
+        return result;
+    }
+    result.reserve(size_of_cont(xs) - length + 1);
+    for (std::size_t idx = 0; idx + length <= size_of_cont(xs); ++idx) {
+        result.push_back({ xs.data() + idx, length });
+    }
+    return result;
+}
+
+// API search type: for_each_split_by_view : ((SpanView a -> ()), (a -> Bool), Bool, [a]) -> ()
+// fwd bind count: 3
+// Calls f with a view of every piece split_by_views would return,
+// without storing them in a vector.
+template <typename F, typename UnaryPredicate, typename Container>
+void for_each_split_by_view(F f, UnaryPredicate pred, bool allow_empty,
+    const Container& xs)
+{
+    internal::check_unary_predicate_for_container<UnaryPredicate, Container>();
+    const auto data = xs.data();
+    const std::size_t size = size_of_cont(xs);
+    internal::visit_split_pieces(
+        [&](std::size_t start) {
+            const auto stop = std::find_if(data + start, data + size, pred);
+            return std::make_pair(
+                static_cast<std::size_t>(stop - data), std::size_t(1));
+        },
+        allow_empty, size,
+        [&](std::size_t idx_begin, std::size_t idx_end) {
+            internal::invoke(f, internal::view_t<Container>(
+                                    data + idx_begin, idx_end - idx_begin));
+        });
+}
+
+// API search type: split_by_views : ((a -> Bool), Bool, [a]) -> [SpanView a]
+// fwd bind count: 2
+// Like split_by, but returns views instead of copies.
+// Views into strings are std::string_views if available (C++17).
+// split_by_views(is_even, true, [1,3,2,2,5,5,3,6,7,9]) == [[1,3],[],[5,5,3],[7,9]]
+// O(n)
+template <typename UnaryPredicate, typename Container>
+std::vector<internal::view_t<Container>>
+split_by_views(UnaryPredicate pred, bool allow_empty, const Container& xs)
+{
+    std::vector<internal::view_t<Container>> result;
+    for_each_split_by_view([&](const internal::view_t<Container>& view) {
+        result.push_back(view);
+    },
+        pred, allow_empty, xs);
+    return result;
+}
+
+// API search type: split_views : (a, Bool, [a]) -> [SpanView a]
+// fwd bind count: 2
+// Like split, but returns views instead of copies.
+// split_views(',', true, "a,,b") == ["a", "", "b"]
+template <typename Container,
+    typename T = typename Container::value_type>
+std::vector<internal::view_t<Container>>
+split_views(const T& x, bool allow_empty, const Container& xs)
+{
+    return split_by_views(is_equal_to(x), allow_empty, xs);
+}
+
+// API search type: split_one_of_views : ([a], Bool, [a]) -> [SpanView a]
+// fwd bind count: 2
+// Like split_one_of, but returns views instead of copies.
+// split_one_of_views(" o", false, "How are u?") == ["H","w","are","u?"]
+template <typename Container, typename ContainerDelims>
+std::vector<internal::view_t<Container>>
+split_one_of_views(const ContainerDelims& delimiters, bool allow_empty,
+    const Container& xs)
+{
+    const auto pred = [&](const typename Container::value_type& x) -> bool {
+        return is_elem_of(x, delimiters);
+    };
+    return split_by_views(pred, allow_empty, xs);
+}
+
+// API search type: for_each_line_view : ((SpanView Char -> ()), Bool, String) -> ()
+// fwd bind count: 2
+// Calls f with a view of every line split_lines_views would return,
+// without storing them in a vector.
+template <typename F, typename String>
+void for_each_line_view(F f, bool allow_empty, const String& str)
+{
+    const auto data = str.data();
+    const std::size_t size = size_of_cont(str);
+    internal::visit_split_pieces(
+        [&](std::size_t start) {
+            return internal::find_line_break(data, size, start);
+        },
+        allow_empty, size,
+        [&](std::size_t idx_begin, std::size_t idx_end) {
+            internal::invoke(f, internal::view_t<String>(
+                                    data + idx_begin, idx_end - idx_begin));
+        });
+}
+
+// API search type: split_lines_views : (Bool, String) -> [SpanView Char]
+// fwd bind count: 1
+// Like split_lines, but returns views instead of copies.
+// Views into strings are std::string_views if available (C++17).
+// Windows ("\r\n") and old Mac ("\r") line breaks are handled
+// without creating a cleaned copy of the input.
+// split_lines_views(false, "Hi,\r\nhow are you?") == ["Hi,", "how are you?"]
+template <typename String>
+std::vector<internal::view_t<String>>
+split_lines_views(bool allow_empty, const String& str)
+{
+    std::vector<internal::view_t<String>> result;
+    for_each_line_view([&](const internal::view_t<String>& view) {
+        result.push_back(view);
+    },
+        allow_empty, str);
+    return result;
+}
+
+} // namespace fplus
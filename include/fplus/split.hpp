@@ -40,13 +40,12 @@ ContainerOut group_by(BinaryPredicate p, const ContainerIn& xs)
     ContainerOut result;
     if (is_empty(xs))
         return result;
-    typedef typename ContainerOut::value_type InnerContainerOut;
-    *internal::get_back_inserter(result) = InnerContainerOut(1, xs.front());
+    *internal::get_back_inserter(result) = internal::singleton_like(xs.front(), xs);
     for (auto it = ++std::begin(xs); it != std::end(xs); ++it) {
         if (internal::invoke(p, result.back().back(), *it))
             *internal::get_back_inserter(result.back()) = *it;
         else
-            *internal::get_back_inserter(result) = InnerContainerOut(1, *it);
+            *internal::get_back_inserter(result) = internal::singleton_like(*it, xs);
     }
     return result;
 }
@@ -118,7 +117,6 @@ ContainerOut group_globally_by(BinaryPredicate p, const ContainerIn& xs)
     static_assert(std::is_same<ContainerIn,
                       typename ContainerOut::value_type>::value,
         "Containers do not match.");
-    typedef typename ContainerOut::value_type InnerContainerOut;
     ContainerOut result;
     for (const auto& x : xs) {
         bool found = false;
@@ -130,7 +128,7 @@ ContainerOut group_globally_by(BinaryPredicate p, const ContainerIn& xs)
             }
         }
         if (!found) {
-            *internal::get_back_inserter(result) = InnerContainerOut(1, x);
+            *internal::get_back_inserter(result) = internal::singleton_like(x, xs);
         }
     }
     return result;
@@ -293,25 +291,26 @@ ContainerOut split_by(UnaryPredicate pred, bool allow_empty, const ContainerIn&
                       typename ContainerOut::value_type>::value,
         "Containers do not match.");
 
+    ContainerOut result;
+    auto itOut = internal::get_back_inserter(result);
     if (allow_empty && is_empty(xs)) {
-        return { {} };
+        *itOut = internal::new_container_like<ContainerIn>(xs);
+        return result;
     }
 
-    ContainerOut result;
-    auto itOut = internal::get_back_inserter(result);
     auto start = std::begin(xs);
 
     while (start != std::end(xs)) {
         const auto stop = std::find_if(start, std::end(xs), pred);
         if (start != stop || allow_empty) {
-            *itOut = { start, stop };
+            *itOut = internal::segment_like(start, stop, xs);
         }
         if (stop == std::end(xs)) {
             break;
         }
         start = internal::add_to_iterator(stop);
         if (allow_empty && start == std::end(xs)) {
-            *itOut = typename ContainerOut::value_type();
+            *itOut = internal::new_container_like<ContainerIn>(xs);
         }
     }
     return result;
@@ -340,7 +339,7 @@ ContainerOut split_by_keep_separators(UnaryPredicate pred, const ContainerIn& xs
     while (start != std::end(xs)) {
         const auto stop = std::find_if(
             internal::add_to_iterator(start), std::end(xs), pred);
-        *itOut = { start, stop };
+        *itOut = internal::segment_like(start, stop, xs);
         if (stop == std::end(xs)) {
             break;
         }
@@ -403,7 +402,7 @@ template <typename Container>
 std::pair<Container, Container> split_at_idx(std::size_t idx, const Container& xs)
 {
     assert(idx <= size_of_cont(xs));
-    return make_pair(get_segment(0, idx, xs),
+    return std::make_pair(get_segment(0, idx, xs),
         get_segment(idx, size_of_cont(xs), xs));
 }
 
@@ -432,8 +431,8 @@ template <typename UnaryPredicate, typename Container>
 std::pair<Container, Container> partition(UnaryPredicate pred, const Container& xs)
 {
     internal::check_unary_predicate_for_container<UnaryPredicate, Container>();
-    Container matching;
-    Container notMatching;
+    auto matching = internal::new_container_like<Container>(xs);
+    auto notMatching = internal::new_container_like<Container>(xs);
     auto itOutMatching = internal::get_back_inserter(matching);
     auto itOutNotMatching = internal::get_back_inserter(notMatching);
     for (const auto& x : xs) {
@@ -442,7 +441,7 @@ std::pair<Container, Container> partition(UnaryPredicate pred, const Container&
         else
             *itOutNotMatching = x;
     }
-    return make_pair(matching, notMatching);
+    return std::make_pair(std::move(matching), std::move(notMatching));
 }
 
 // API search type: split_at_idxs : ([Int], [a]) -> [[a]]
@@ -7,12 +7,17 @@
 #pragma once
 
 #include <fplus/replace.hpp>
+#include <fplus/span_view.hpp>
 #include <fplus/split.hpp>
 #include <fplus/transform.hpp>
 
+#include <fplus/internal/ascii.hpp>
+
+#include <algorithm>
 #include <cctype>
 #include <locale>
 #include <string>
+#include <type_traits>
 
 namespace fplus {
 
@@ -43,14 +48,144 @@ bool is_line_break(const typename String::value_type& c)
     return c == '\n';
 }
 
+namespace internal {
+
+    // std::strings get vectorized ASCII fast paths.
+    template <typename String>
+    using is_char_string = std::integral_constant<bool,
+        is_basic_string<String>::value
+            && std::is_same<typename String::value_type, char>::value>;
+
+    template <typename String>
+    String from_std_string(std::true_type, std::string&& str)
+    {
+        return std::move(str);
+    }
+
+    // For std::basic_strings of char with other traits or allocators.
+    template <typename String>
+    String from_std_string(std::false_type, std::string&& str)
+    {
+        return String(std::begin(str), std::end(str));
+    }
+
+    template <typename String>
+    String clean_newlines(std::true_type, const String& str)
+    {
+        return from_std_string<String>(std::is_same<String, std::string>(),
+            ascii_clean_newlines(str.data(), str.size()));
+    }
+
+    template <typename String>
+    String clean_newlines(std::false_type, const String& str)
+    {
+        return fplus::replace_elems('\r', '\n',
+            fplus::replace_tokens(String("\r\n"), String("\n"), str));
+    }
+
+    template <typename String>
+    std::size_t count_line_breaks(std::true_type, const String& str)
+    {
+        return ascii_count_line_breaks(str.data(), str.size());
+    }
+
+    template <typename String>
+    std::size_t count_line_breaks(std::false_type, const String& str)
+    {
+        std::size_t result = 0;
+        for (auto it = std::begin(str); it != std::end(str); ++it) {
+            if (*it == '\n') {
+                ++result;
+            } else if (*it == '\r') {
+                const auto next = std::next(it);
+                if (next == std::end(str) || *next != '\n') {
+                    ++result;
+                }
+            }
+        }
+        return result;
+    }
+
+    template <typename String>
+    String trim_whitespace_left(std::true_type, const String& str)
+    {
+        return str.substr(ascii_skip_whitespace_left(str.data(), str.size()));
+    }
+
+    template <typename String>
+    String trim_whitespace_left(std::false_type, const String& str)
+    {
+        return fplus::drop_while(is_whitespace<String>, str);
+    }
+
+    template <typename String>
+    String trim_whitespace_right(std::true_type, const String& str)
+    {
+        return str.substr(0, ascii_skip_whitespace_right(str.data(), str.size()));
+    }
+
+    template <typename String>
+    String trim_whitespace_right(std::false_type, const String& str)
+    {
+        return fplus::trim_right_by(is_whitespace<String>, str);
+    }
+
+    template <typename String>
+    String trim_whitespace(std::true_type, const String& str)
+    {
+        const std::size_t idx_begin = ascii_skip_whitespace_left(str.data(), str.size());
+        const std::size_t idx_end = idx_begin
+            + ascii_skip_whitespace_right(str.data() + idx_begin, str.size() - idx_begin);
+        return str.substr(idx_begin, idx_end - idx_begin);
+    }
+
+    template <typename String>
+    String trim_whitespace(std::false_type, const String& str)
+    {
+        return fplus::trim_by(is_whitespace<String>, str);
+    }
+
+    template <bool ToUpper, typename String>
+    String change_case(std::true_type, const String& str)
+    {
+        String result = str;
+        if (!result.empty()) {
+            ascii_change_case<ToUpper>(&result[0], result.size());
+        }
+        return result;
+    }
+
+    template <bool ToUpper, typename String>
+    String change_case(std::false_type, const String& str)
+    {
+        typedef typename String::value_type Char;
+        return fplus::transform([](Char c) -> Char {
+            const auto uc = static_cast<unsigned char>(c);
+            return static_cast<Char>(
+                ToUpper ? std::toupper(uc) : std::tolower(uc));
+        },
+            str);
+    }
+
+} // namespace internal
+
 // API search type: clean_newlines : String -> String
 // fwd bind count: 0
 // Replaces windows and mac newlines with linux newlines.
 template <typename String>
 String clean_newlines(const String& str)
 {
-    return replace_elems('\r', '\n',
-        replace_tokens(String("\r\n"), String("\n"), str));
+    return internal::clean_newlines(internal::is_char_string<String>(), str);
+}
+
+// API search type: count_line_breaks : String -> Int
+// fwd bind count: 0
+// Counts the linux ("\n"), windows ("\r\n") and mac ("\r") newlines.
+// count_line_breaks("a\nb\r\nc\rd") == 3
+template <typename String>
+std::size_t count_line_breaks(const String& str)
+{
+    return internal::count_line_breaks(internal::is_char_string<String>(), str);
 }
 
 // API search type: split_words : (Bool, String) -> [String]
@@ -63,6 +198,18 @@ ContainerOut split_words(const bool allowEmpty, const String& str)
     return split_by(logical_not(is_letter_or_digit<String>), allowEmpty, str);
 }
 
+// API search type: split_words_views : (Bool, String) -> [SpanView Char]
+// fwd bind count: 1
+// Like split_words, but returns views instead of copies,
+// std::string_views if available (C++17).
+// split_words_views(false, "How are you?") == ["How", "are", "you"]
+template <typename String>
+std::vector<internal::view_t<String>> split_words_views(
+    bool allowEmpty, const String& str)
+{
+    return split_by_views(logical_not(is_letter_or_digit<String>), allowEmpty, str);
+}
+
 // API search type: split_lines : (Bool, String) -> [String]
 // fwd bind count: 1
 // Splits a string by the found newlines.
@@ -79,7 +226,7 @@ ContainerOut split_lines(bool allowEmpty, const String& str)
 template <typename String>
 String trim_whitespace_left(const String& str)
 {
-    return drop_while(is_whitespace<String>, str);
+    return internal::trim_whitespace_left(internal::is_char_string<String>(), str);
 }
 
 // API search type: trim_whitespace_right : String -> String
@@ -89,7 +236,7 @@ String trim_whitespace_left(const String& str)
 template <typename String>
 String trim_whitespace_right(const String& str)
 {
-    return trim_right_by(is_whitespace<String>, str);
+    return internal::trim_whitespace_right(internal::is_char_string<String>(), str);
 }
 
 // API search type: trim_whitespace : String -> String
@@ -99,7 +246,7 @@ String trim_whitespace_right(const String& str)
 template <typename String>
 String trim_whitespace(const String& str)
 {
-    return trim_by(is_whitespace<String>, str);
+    return internal::trim_whitespace(internal::is_char_string<String>(), str);
 }
 
 // API search type: to_lower_case : String -> String
@@ -109,12 +256,7 @@ String trim_whitespace(const String& str)
 template <typename String>
 String to_lower_case(const String& str)
 {
-    typedef typename String::value_type Char;
-    return transform([](Char c) -> Char {
-        return static_cast<Char>(
-            std::tolower(static_cast<unsigned char>(c)));
-    },
-        str);
+    return internal::change_case<false>(internal::is_char_string<String>(), str);
 }
 
 // API search type: to_lower_case_loc : (Locale, String) -> String
@@ -139,12 +281,7 @@ String to_lower_case_loc(const std::locale& lcl, const String& str)
 template <typename String>
 String to_upper_case(const String& str)
 {
-    typedef typename String::value_type Char;
-    return transform([](Char c) -> Char {
-        return static_cast<Char>(
-            std::toupper(static_cast<unsigned char>(c)));
-    },
-        str);
+    return internal::change_case<true>(internal::is_char_string<String>(), str);
 }
 
 // API search type: to_upper_case_loc : (Locale, String) -> String
@@ -171,7 +308,14 @@ template <typename T>
 std::string to_string_fill_left(const std::string::value_type& filler,
     std::size_t min_size, const T& x)
 {
-    return fill_left(filler, min_size, std::to_string(x));
+    const std::string str = std::to_string(x);
+    std::string result;
+    result.reserve(std::max(min_size, str.size()));
+    if (str.size() < min_size) {
+        result.append(min_size - str.size(), filler);
+    }
+    result += str;
+    return result;
 }
 
 // API search type: to_string_fill_right : (Char, Int, a) -> String
@@ -182,7 +326,11 @@ template <typename T>
 std::string to_string_fill_right(const std::string::value_type& filler,
     std::size_t min_size, const T& x)
 {
-    return fill_right(filler, min_size, std::to_string(x));
+    std::string result = std::to_string(x);
+    if (result.size() < min_size) {
+        result.append(min_size - result.size(), filler);
+    }
+    return result;
 }
 
 } // namespace fplus
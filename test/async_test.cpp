@@ -0,0 +1,133 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("async_test - execute_async")
+{
+    using namespace fplus;
+    const auto fut = execute_async([]() { return 42; });
+    REQUIRE_EQ(fut.get(), 42);
+    REQUIRE(fut.is_ready());
+
+    std::atomic<int> counter(0);
+    REQUIRE(execute_async([&counter]() { ++counter; }).get());
+    REQUIRE_EQ(counter.load(), 1);
+}
+
+TEST_CASE("async_test - thread_pool")
+{
+    using namespace fplus;
+    std::atomic<int> counter(0);
+    {
+        thread_pool pool(1);
+        pool.post([]() { throw std::runtime_error("fail"); });
+        pool.post([&counter]() { ++counter; });
+    }
+    REQUIRE_EQ(counter.load(), 1);
+}
+
+TEST_CASE("async_test - then")
+{
+    using namespace fplus;
+    const auto fut = execute_async([]() { return 3; })
+                         .then([](int x) { return x * x; })
+                         .then([](int x) { return std::to_string(x); });
+    REQUIRE_EQ(fut.get(), std::string("9"));
+
+    const auto failed = execute_async([]() -> int { throw std::runtime_error("fail"); })
+                            .then([](int x) { return x + 1; });
+    bool caught = false;
+    try {
+        failed.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+}
+
+TEST_CASE("async_test - async_promise")
+{
+    using namespace fplus;
+    const async_promise<int> promise;
+    const auto fut = promise.get_future().then([](int x) { return x + 1; });
+    REQUIRE_FALSE(promise.get_future().is_ready());
+    promise.set_value(1);
+    REQUIRE_EQ(fut.get(), 2);
+
+    bool already_satisfied = false;
+    try {
+        promise.set_value(3);
+    } catch (const std::future_error& e) {
+        already_satisfied = e.code() == std::future_errc::promise_already_satisfied;
+    }
+    REQUIRE(already_satisfied);
+    REQUIRE_EQ(fut.get(), 2);
+
+    const auto broken_fut = []() {
+        const async_promise<int> original;
+        const auto copy = original;
+        return copy.get_future();
+    }();
+    bool broken = false;
+    try {
+        broken_fut.get();
+    } catch (const std::future_error& e) {
+        broken = e.code() == std::future_errc::broken_promise;
+    }
+    REQUIRE(broken);
+}
+
+TEST_CASE("async_test - when_all")
+{
+    using namespace fplus;
+    std::vector<async_future<int>> futs;
+    for (int i = 0; i < 10; ++i) {
+        futs.push_back(execute_async([i]() { return i * i; }));
+    }
+    REQUIRE_EQ(when_all(futs).get(), std::vector<int>({ 0, 1, 4, 9, 16, 25, 36, 49, 64, 81 }));
+    REQUIRE_EQ(when_all(std::vector<async_future<int>>()).get(), std::vector<int>());
+
+    futs.push_back(execute_async([]() -> int { throw std::runtime_error("fail"); }));
+    bool caught = false;
+    try {
+        when_all(futs).get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+}
+
+TEST_CASE("async_test - when_any")
+{
+    using namespace fplus;
+    const async_promise<int> never;
+    const std::vector<async_future<int>> futs = {
+        never.get_future(),
+        execute_async([]() { return 7; })
+    };
+    REQUIRE_EQ(when_any(futs).get(), std::make_pair(std::size_t(1), 7));
+    never.set_value(0);
+}
+
+TEST_CASE("async_test - adapt effects")
+{
+    using namespace fplus;
+    std::vector<int> buffer;
+    auto push_one = [&]() { buffer.push_back(1); return 1; };
+    REQUIRE_EQ(execute_async(execute_serially(replicate(3, push_one))).get(), std::vector<int>({ 1, 1, 1 }));
+    REQUIRE_EQ(buffer, std::vector<int>({ 1, 1, 1 }));
+
+    std::atomic<int> attempts(0);
+    auto succeed_third_time = [&]() { return ++attempts == 3; };
+    REQUIRE(execute_async(execute_max_n_times_until_success(5, succeed_third_time)).get());
+    REQUIRE_EQ(attempts.load(), 3);
+}
@@ -7,6 +7,7 @@
 #include <deque>
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <limits>
 #include <vector>
 
 namespace {
@@ -312,6 +313,8 @@ TEST_CASE("container_common_test - fill")
     REQUIRE_EQ(fill_left(0, 6, IntVector({ 1, 2, 3, 4 })), IntVector({ 0, 0, 1, 2, 3, 4 }));
     REQUIRE_EQ(fill_right(0, 6, IntList({ 1, 2, 3, 4 })), IntList({ 1, 2, 3, 4, 0, 0 }));
     REQUIRE_EQ(fill_left(' ', 6, std::string("12")), std::string("    12"));
+    REQUIRE_EQ(fill_right('x', 3, std::string("12")), std::string("12x"));
+    REQUIRE_EQ(fill_left(0, 2, IntList({ 1, 2, 3 })), IntList({ 1, 2, 3 }));
 }
 
 TEST_CASE("container_common_test - intersperse")
@@ -355,6 +358,11 @@ TEST_CASE("container_common_test - join")
     using namespace fplus;
     REQUIRE_EQ(join(std::string(", "), std::vector<std::string>({ "a", "b", "sea" })), std::string("a, b, sea"));
     REQUIRE_EQ(join(IntList({ 0 }), intLists), IntList({ 1, 0, 2, 2, 0, 3, 0, 2 }));
+    REQUIRE_EQ(join(std::string(", "), std::vector<std::string>()), std::string());
+    REQUIRE_EQ(join(std::string(", "), std::vector<std::string>({ "a" })), std::string("a"));
+    REQUIRE_EQ(join(std::string(), std::vector<std::string>({ "a", "", "b" })), std::string("ab"));
+    const std::string joined = join(std::string(", "), std::vector<std::string>(100, "abc"));
+    REQUIRE_EQ(joined.size(), 100 * 3 + 99 * 2);
 }
 
 TEST_CASE("container_common_test - join_elem")
@@ -478,6 +486,14 @@ TEST_CASE("container_common_test - all_unique")
 
     REQUIRE_EQ(all_unique_on(int_mod_10, IntVector({ 3, 14, 35 })), true);
     REQUIRE_EQ(all_unique_on(int_mod_10, IntVector({ 3, 14, 33 })), false);
+
+    REQUIRE_EQ(all_unique(IntPairs({ { 1, 2 }, { 2, 1 } })), true);
+    REQUIRE_EQ(all_unique(IntPairs({ { 1, 2 }, { 1, 2 } })), false);
+    REQUIRE_EQ(all_unique(IntVectors({ { 1 }, { 1, 2 }, { 1 } })), false);
+
+    const auto bothEven = is_equal_by(is_even_int);
+    REQUIRE_EQ(all_unique_by_eq(bothEven, IntVector({ 1, 2 })), true);
+    REQUIRE_EQ(all_unique_by_eq(bothEven, IntVector({ 1, 2, 4 })), false);
 }
 
 TEST_CASE("container_common_test - is_sorted")
@@ -648,6 +664,65 @@ TEST_CASE("container_common_test - nub")
     auto bothEven = is_equal_by(is_even_int);
     REQUIRE_EQ(nub_by(bothEven, xs), IntVector({ 1, 2 }));
     REQUIRE_EQ(nub_on(int_mod_10, IntVector({ 12, 32, 15 })), IntVector({ 12, 15 }));
+    REQUIRE_EQ(nub(IntList({ 3, 1, 3, 2, 1 })), IntList({ 3, 1, 2 }));
+    REQUIRE_EQ(nub(std::string("mississippi")), std::string("misp"));
+}
+
+TEST_CASE("container_common_test - nub_without_hash")
+{
+    using namespace fplus;
+    // only less-than comparable
+    REQUIRE_EQ(nub(IntPairs({ { 2, 1 }, { 1, 2 }, { 2, 1 } })),
+        IntPairs({ { 2, 1 }, { 1, 2 } }));
+    REQUIRE_EQ(nub(IntVectors({ { 2 }, {}, { 2 }, {} })),
+        IntVectors({ { 2 }, {} }));
+
+    // only equality comparable
+    struct point {
+        int x;
+        int y;
+        bool operator==(const point& other) const
+        {
+            return x == other.x && y == other.y;
+        }
+    };
+    typedef std::vector<point> points;
+    const points ps = { { 1, 2 }, { 3, 4 }, { 1, 2 } };
+    REQUIRE_EQ(size_of_cont(nub(ps)), 2);
+    REQUIRE_FALSE(all_unique(ps));
+    REQUIRE_EQ(size_of_cont(nub(std::vector<points>({ ps, ps }))), 1);
+    REQUIRE(all_unique(std::vector<points>({ ps, {} })));
+
+    // operator< not matching operator==, which is the one used.
+    struct ranked {
+        int rank;
+        int id;
+        bool operator==(const ranked& other) const
+        {
+            return rank == other.rank && id == other.id;
+        }
+        bool operator<(const ranked& other) const
+        {
+            return rank < other.rank;
+        }
+    };
+    const std::vector<ranked> rs = { { 1, 1 }, { 1, 2 }, { 1, 1 } };
+    REQUIRE_EQ(size_of_cont(nub(rs)), 2);
+    REQUIRE(all_unique(std::vector<ranked>({ { 1, 1 }, { 1, 2 } })));
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    REQUIRE_EQ(size_of_cont(nub(std::vector<std::vector<double>>({ { nan }, { 1.0 }, { 1.0 } }))), 2);
+}
+
+TEST_CASE("container_common_test - nub_large")
+{
+    using namespace fplus;
+    const auto ys = transform([](int x) { return x % 1000; },
+        numbers(0, 200000));
+    REQUIRE_EQ(nub(ys), numbers(0, 1000));
+    REQUIRE_EQ(nub_on(int_mod_10, ys), numbers(0, 10));
+    REQUIRE_FALSE(all_unique(ys));
+    REQUIRE(all_unique(numbers(0, 200000)));
+    REQUIRE(all_unique_on(show<int>, numbers(0, 200000)));
 }
 
 TEST_CASE("container_common_test - coucount_occurrences_bynt_occurrences_on")
@@ -737,3 +812,77 @@ TEST_CASE("composition_test - instead_of_if_empty")
     REQUIRE_EQ(instead_of_if_empty(xs_alt, xs_empty), xs_alt);
     REQUIRE_EQ(instead_of_if_empty(xs_alt, xs_full), xs_full);
 }
+
+TEST_CASE("container_common_test - transform_into")
+{
+    using namespace fplus;
+    IntVector ys = { 7, 7, 7, 7, 7, 7, 7, 7 };
+    const auto capacity = ys.capacity();
+    const auto data = ys.data();
+    transform_into(squareLambda, xs, ys);
+    REQUIRE_EQ(ys, IntVector({ 1, 4, 4, 9, 4 }));
+    REQUIRE_EQ(ys.capacity(), capacity);
+    REQUIRE_EQ(ys.data(), data);
+    transform_into(squareLambda, intList, ys);
+    REQUIRE_EQ(ys, IntVector({ 1, 4, 4, 9, 4 }));
+    IntList zs;
+    transform_into(squareLambda, xs, zs);
+    REQUIRE_EQ(zs, IntList({ 1, 4, 4, 9, 4 }));
+    std::string str = "foo";
+    transform_into([](char c) { return static_cast<char>(c + 1); }, ABC_, str);
+    REQUIRE_EQ(str, std::string("BCD"));
+    int arr[5] = {};
+    const auto it_end = transform_into(squareLambda, xs, std::begin(arr));
+    REQUIRE_EQ(it_end, std::end(arr));
+    REQUIRE_EQ(IntVector(std::begin(arr), std::end(arr)), IntVector({ 1, 4, 4, 9, 4 }));
+    IntVector appended = { 0 };
+    transform_into(squareLambda, xs, std::back_inserter(appended));
+    REQUIRE_EQ(appended, IntVector({ 0, 1, 4, 4, 9, 4 }));
+}
+
+TEST_CASE("container_common_test - elems_at_idxs_into")
+{
+    using namespace fplus;
+    IntVector ys = { 7, 7, 7 };
+    elems_at_idxs_into(IdxVector({ 4, 1, 3 }), xs, ys);
+    REQUIRE_EQ(ys, IntVector({ 2, 2, 3 }));
+    elems_at_idxs_into(IdxVector(), xs, ys);
+    REQUIRE_EQ(ys, IntVector());
+}
+
+TEST_CASE("container_common_test - append_into")
+{
+    using namespace fplus;
+    IntVector ys = { 7 };
+    append_into(xs, IntVector({ 8, 9 }), ys);
+    REQUIRE_EQ(ys, append(xs, IntVector({ 8, 9 })));
+    IntVector zs;
+    append_into(IntVector({ 1 }), intList, std::back_inserter(zs));
+    REQUIRE_EQ(zs, IntVector({ 1, 1, 2, 2, 3, 2 }));
+}
+
+TEST_CASE("container_common_test - concat_into")
+{
+    using namespace fplus;
+    IntList ys = { 7 };
+    concat_into(intLists, ys);
+    REQUIRE_EQ(ys, concat(intLists));
+    IntVector zs = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const auto capacity = zs.capacity();
+    concat_into(IntVectors({ { 1 }, {}, { 2, 3 } }), zs);
+    REQUIRE_EQ(zs, IntVector({ 1, 2, 3 }));
+    REQUIRE_EQ(zs.capacity(), capacity);
+}
+
+TEST_CASE("container_common_test - join_into")
+{
+    using namespace fplus;
+    std::string str = "foo";
+    join_into(std::string(", "), string_vec({ "a", "bee", "cee" }), str);
+    REQUIRE_EQ(str, std::string("a, bee, cee"));
+    join_into(std::string(", "), string_vec(), str);
+    REQUIRE_EQ(str, std::string());
+    IntVector ys;
+    join_into(IntVector({ 0, 0 }), IntVectors({ { 1 }, { 2 }, { 3, 4 } }), ys);
+    REQUIRE_EQ(ys, IntVector({ 1, 0, 0, 2, 0, 0, 3, 4 }));
+}
@@ -5,7 +5,10 @@
 //  http://www.boost.org/LICENSE_1_0.txt)
 
 #include <doctest/doctest.h>
+#include <cmath>
 #include <fplus/fplus.hpp>
+#include <list>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -115,6 +118,52 @@ TEST_CASE("container_properties_test - mean")
     REQUIRE(is_in_interval(2.16f, 2.17f, mean_stddev<float>(IntVector({ 1, 3, 7, 4 })).second));
 }
 
+TEST_CASE("container_properties_test - moments")
+{
+    using namespace fplus;
+    typedef std::vector<double> DoubleVector;
+    typedef std::vector<float> FloatVector;
+    REQUIRE_EQ(variance<double>(DoubleVector({ 4, 8 })), doctest::Approx(4));
+    REQUIRE_EQ(variance<double>(IntVector({ 5 })), doctest::Approx(0));
+    REQUIRE_EQ(skewness<double>(IntVector({ 1, 2, 3 })), doctest::Approx(0));
+    REQUIRE_EQ(skewness<double>(IntVector({ 1, 2, 6 })), doctest::Approx(0.5952).epsilon(0.001));
+    REQUIRE_EQ(skewness<double>(IntVector({ 6, 2, 1 })), doctest::Approx(0.5952).epsilon(0.001));
+    REQUIRE_EQ(kurtosis<double>(IntVector({ 1, 2, 3, 4 })), doctest::Approx(1.64));
+    REQUIRE_EQ(kurtosis<double>(std::list<int>({ 1, 2, 3, 4 })), doctest::Approx(1.64));
+    REQUIRE_EQ(mean_stddev<int>(IntVector({ 4, 8 })), std::make_pair(6, 2));
+
+    // Large offsets do not cancel out the small differences.
+    const FloatVector offset = { 10004, 10007, 10013, 10016 };
+    REQUIRE_EQ(mean_stddev<float>(offset).first, doctest::Approx(10010));
+    REQUIRE_EQ(mean_stddev<float>(offset).second, doctest::Approx(std::sqrt(22.5)));
+
+    // Contiguous sequences are processed block by block,
+    // others one element at a time.
+    DoubleVector ys;
+    for (std::size_t i = 0; i < 10007; ++i) {
+        ys.push_back(static_cast<double>((i * 7919) % 1000) / 10.0 + 5000.0);
+    }
+    const std::list<double> ys_list(ys.begin(), ys.end());
+    const double n = static_cast<double>(ys.size());
+    const double mean = sum(ys) / n;
+    double m2 = 0;
+    double m3 = 0;
+    double m4 = 0;
+    for (const double y : ys) {
+        m2 += (y - mean) * (y - mean);
+        m3 += (y - mean) * (y - mean) * (y - mean);
+        m4 += (y - mean) * (y - mean) * (y - mean) * (y - mean);
+    }
+    for (const auto& ms : { mean_stddev<double>(ys), mean_stddev<double>(ys_list) }) {
+        REQUIRE_EQ(ms.first, doctest::Approx(mean));
+        REQUIRE_EQ(ms.second, doctest::Approx(std::sqrt(m2 / n)));
+    }
+    REQUIRE_EQ(skewness<double>(ys), doctest::Approx(std::sqrt(n) * m3 / std::pow(m2, 1.5)));
+    REQUIRE_EQ(skewness<double>(ys_list), doctest::Approx(std::sqrt(n) * m3 / std::pow(m2, 1.5)));
+    REQUIRE_EQ(kurtosis<double>(ys), doctest::Approx(n * m4 / (m2 * m2)));
+    REQUIRE_EQ(kurtosis<double>(ys_list), doctest::Approx(n * m4 / (m2 * m2)));
+}
+
 TEST_CASE("container_properties_test - all_unique_less")
 {
     using namespace fplus;
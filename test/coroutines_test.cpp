@@ -0,0 +1,137 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+namespace {
+template <typename T>
+std::vector<T> to_vector(fplus::generator<T> xs)
+{
+    std::vector<T> result;
+    for (const auto& x : xs) {
+        result.push_back(x);
+    }
+    return result;
+}
+typedef std::vector<int> IntVector;
+}
+
+TEST_CASE("coroutines_test - iterate_lazily")
+{
+    using namespace fplus;
+    const auto times_2 = [](int x) { return 2 * x; };
+    REQUIRE_EQ(to_vector(take_lazily(5, iterate_lazily(times_2, 3))), IntVector({ 3, 6, 12, 24, 48 }));
+    REQUIRE_EQ(to_vector(take_lazily(0, iterate_lazily(times_2, 3))), IntVector());
+}
+
+TEST_CASE("coroutines_test - numbers_lazily")
+{
+    using namespace fplus;
+    REQUIRE_EQ(to_vector(numbers_lazily(2, 9)), numbers(2, 9));
+    REQUIRE_EQ(to_vector(numbers_lazily(9, 2)), IntVector());
+    std::size_t sum = 0;
+    for (const std::size_t x : numbers_lazily<std::size_t>(0, 10000000)) {
+        sum += x;
+    }
+    REQUIRE_EQ(sum, std::size_t(49999995000000));
+}
+
+TEST_CASE("coroutines_test - infixes_lazily")
+{
+    using namespace fplus;
+    const IntVector xs = { 1, 2, 3, 4, 5, 6 };
+    REQUIRE_EQ(to_vector(infixes_lazily(3, xs)), infixes(3, xs));
+    REQUIRE_EQ(to_vector(infixes_lazily(7, xs)), infixes(7, xs));
+}
+
+TEST_CASE("coroutines_test - carthesian_product_lazily")
+{
+    using namespace fplus;
+    const std::string xs = "ABC";
+    const std::string ys = "XY";
+    REQUIRE_EQ(to_vector(carthesian_product_lazily(xs, ys)), carthesian_product(xs, ys));
+}
+
+TEST_CASE("coroutines_test - combinatorics_lazily")
+{
+    using namespace fplus;
+    const std::string xs = "ABCD";
+    for (std::size_t power = 0; power <= 5; ++power) {
+        REQUIRE_EQ(to_vector(permutations_lazily(power, xs)), permutations(power, xs));
+        REQUIRE_EQ(to_vector(combinations_lazily(power, xs)), combinations(power, xs));
+    }
+    REQUIRE_EQ(to_vector(power_set_lazily(xs)), power_set(xs));
+    REQUIRE_EQ(to_vector(power_set_lazily(std::string())), power_set(std::string()));
+
+    std::size_t count = 0;
+    for (const auto& perm : permutations_lazily(12, numbers(0, 12))) {
+        if (++count == 1000) {
+            REQUIRE_EQ(perm.size(), std::size_t(12));
+            break;
+        }
+    }
+    REQUIRE_EQ(count, std::size_t(1000));
+}
+
+TEST_CASE("coroutines_test - generator exceptions")
+{
+    using namespace fplus;
+    const auto throw_at_3 = [](int x) {
+        if (x == 3) {
+            throw std::runtime_error("three");
+        }
+        return x + 1;
+    };
+    IntVector seen;
+    bool caught = false;
+    try {
+        for (const int x : iterate_lazily(throw_at_3, 0)) {
+            seen.push_back(x);
+        }
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+    REQUIRE_EQ(seen, IntVector({ 0, 1, 2, 3 }));
+}
+
+namespace {
+fplus::task<int> add_async(int a, int b)
+{
+    const int x = co_await fplus::execute_effect_async([a]() { return a; });
+    const int y = co_await fplus::execute_as_task([b]() { return b; });
+    co_return x + y;
+}
+
+fplus::task<int> fail_async()
+{
+    co_await fplus::execute_effect_async([]() -> int { throw std::runtime_error("fail"); });
+    co_return 0;
+}
+}
+
+TEST_CASE("coroutines_test - task")
+{
+    using namespace fplus;
+    REQUIRE_EQ(add_async(1, 2).get(), 3);
+    REQUIRE_EQ(execute_as_task([]() { return std::string("hi"); }).get(), std::string("hi"));
+    REQUIRE(execute_as_task([]() {}).get());
+
+    bool caught = false;
+    try {
+        fail_async().get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+}
+
+#endif
@@ -246,3 +246,19 @@ TEST_CASE("filter_test - adjacent_keep_fst_if")
     REQUIRE_EQ(fplus::adjacent_keep_fst_if(std::greater<>(), v), std::vector<int>({ 9, 1 }));
     REQUIRE_EQ(fplus::adjacent_keep_fst_if(std::less<int>(), v), std::vector<int>({ 0, 1, 7, 8, 0, 1 }));
 }
+
+TEST_CASE("filter_test - keep_if_into")
+{
+    const IntVector xs = { 1, 2, 2, 3, 2 };
+    IntVector ys = { 7, 7, 7, 7, 7, 7, 7, 7 };
+    const auto capacity = ys.capacity();
+    fplus::keep_if_into(is_even, xs, ys);
+    REQUIRE_EQ(ys, IntVector({ 2, 2, 2 }));
+    REQUIRE_EQ(ys.capacity(), capacity);
+    fplus::drop_if_into(is_even, xs, ys);
+    REQUIRE_EQ(ys, IntVector({ 1, 3 }));
+    std::list<int> zs;
+    fplus::keep_if_into(is_even, xs, std::back_inserter(zs));
+    fplus::drop_if_into(is_even, xs, std::back_inserter(zs));
+    REQUIRE_EQ(zs, std::list<int>({ 2, 2, 2, 1, 3 }));
+}
@@ -6,6 +6,8 @@
 
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <limits>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -205,6 +207,149 @@ TEST_CASE("generate_test - power_set")
     REQUIRE_EQ(result[3], std::vector<char>({ 'x', 'y' }));
 }
 
+TEST_CASE("generate_test - combinatorics_match_carthesian_product_n")
+{
+    using namespace fplus;
+    typedef std::vector<std::string> Strings;
+    const std::string xs = "ABCDE";
+    for (std::size_t power = 1; power <= 6; ++power) {
+        const auto product = carthesian_product_n(power, xs);
+        REQUIRE_EQ(permutations(power, xs), keep_if(all_unique<std::string>, product));
+        REQUIRE_EQ(combinations(power, xs), keep_if(is_strictly_sorted<std::string>, product));
+        REQUIRE_EQ(combinations_with_replacement(power, xs), keep_if(is_sorted<std::string>, product));
+    }
+    REQUIRE_EQ(permutations(2, std::string()), Strings());
+    REQUIRE_EQ(combinations_with_replacement(2, std::string()), Strings());
+}
+
+TEST_CASE("generate_test - for_each_permutation")
+{
+    using namespace fplus;
+    typedef std::vector<std::vector<char>> Results;
+    Results visited;
+    const auto collect = [&](const std::vector<char>& perm) {
+        visited.push_back(perm);
+        return true;
+    };
+    REQUIRE(for_each_permutation(2, collect, std::string("ABC")));
+    REQUIRE_EQ(visited, Results({ { 'A', 'B' }, { 'A', 'C' }, { 'B', 'A' }, { 'B', 'C' }, { 'C', 'A' }, { 'C', 'B' } }));
+
+    std::size_t count = 0;
+    const auto stop_after_5 = [&](const std::vector<int>&) {
+        return ++count < 5;
+    };
+    REQUIRE_FALSE(for_each_permutation(20, stop_after_5, numbers(0, 20)));
+    REQUIRE_EQ(count, 5u);
+}
+
+TEST_CASE("generate_test - for_each_combination")
+{
+    using namespace fplus;
+    typedef std::vector<std::vector<char>> Results;
+    Results visited;
+    const auto collect = [&](const std::vector<char>& comb) {
+        visited.push_back(comb);
+        return true;
+    };
+    REQUIRE(for_each_combination(2, collect, std::string("ABC")));
+    REQUIRE_EQ(visited, Results({ { 'A', 'B' }, { 'A', 'C' }, { 'B', 'C' } }));
+
+    visited.clear();
+    REQUIRE(for_each_combination_with_replacement(2, collect, std::string("AB")));
+    REQUIRE_EQ(visited, Results({ { 'A', 'A' }, { 'A', 'B' }, { 'B', 'B' } }));
+
+    visited.clear();
+    REQUIRE(for_each_power_set_elem(collect, std::string("xy")));
+    REQUIRE_EQ(visited, Results({ {}, { 'x' }, { 'y' }, { 'x', 'y' } }));
+
+    visited.clear();
+    const auto stop_at_first = [&](const std::vector<char>& comb) {
+        visited.push_back(comb);
+        return false;
+    };
+    REQUIRE_FALSE(for_each_power_set_elem(stop_at_first, std::string("xy")));
+    REQUIRE_EQ(visited, Results({ {} }));
+}
+
+TEST_CASE("generate_test - nth_permutation")
+{
+    using namespace fplus;
+    const std::string xs = "ABCDE";
+    for (std::size_t power = 0; power <= 5; ++power) {
+        const auto perms = permutations(power, xs);
+        for (std::size_t i = 0; i < perms.size(); ++i) {
+            REQUIRE_EQ(nth_permutation(power, i, xs), perms[i]);
+        }
+        const auto combs = combinations(power, xs);
+        for (std::size_t i = 0; i < combs.size(); ++i) {
+            REQUIRE_EQ(nth_combination(power, i, xs), combs[i]);
+        }
+    }
+    REQUIRE_EQ(nth_permutation(2, 3, std::string("ABCD")), std::string("BA"));
+    REQUIRE_EQ(nth_combination(2, 3, std::string("ABCD")), std::string("BC"));
+}
+
+TEST_CASE("generate_test - permutation_state")
+{
+    using namespace fplus;
+    typedef std::vector<std::size_t> Idxs;
+    permutation_state state(3, 2, 3);
+    REQUIRE(state.is_valid());
+    REQUIRE_EQ(state.idxs(), Idxs({ 1, 2 }));
+    REQUIRE(state.next());
+    REQUIRE_EQ(state.idxs(), Idxs({ 2, 0 }));
+    REQUIRE(state.next());
+    REQUIRE_EQ(state.idxs(), Idxs({ 2, 1 }));
+    REQUIRE_FALSE(state.next());
+    REQUIRE_FALSE(state.is_valid());
+    REQUIRE_FALSE(permutation_state(2, 3).is_valid());
+    REQUIRE_FALSE(permutation_state(3, 2, 6).is_valid());
+
+    // Too many permutations to count them in a std::size_t.
+    permutation_state big(30, 30);
+    REQUIRE(big.is_valid());
+    REQUIRE(big.next());
+    REQUIRE_EQ(big.idxs()[29], 28u);
+
+    combination_state comb(4, 2, 4);
+    REQUIRE_EQ(comb.idxs(), Idxs({ 1, 3 }));
+    REQUIRE(comb.next());
+    REQUIRE_EQ(comb.idxs(), Idxs({ 2, 3 }));
+    REQUIRE_FALSE(comb.next());
+    REQUIRE(combination_state(3, 0).is_valid());
+    REQUIRE_FALSE(combination_state(3, 4).is_valid());
+}
+
+TEST_CASE("generate_test - combinations_near_overflow")
+{
+    using namespace fplus;
+    typedef std::vector<std::size_t> Idxs;
+    if (sizeof(std::size_t) < 8) {
+        return;
+    }
+    const std::size_t max = std::numeric_limits<std::size_t>::max();
+    REQUIRE_EQ(internal::count_k_combinations(64, 32), 1832624140942590534ull);
+    REQUIRE_EQ(internal::count_k_combinations(65, 32), 3609714217008132870ull);
+    REQUIRE_EQ(internal::count_k_combinations(66, 33), 7219428434016265740ull);
+    REQUIRE_EQ(internal::count_k_combinations(67, 33), 14226520737620288370ull);
+    REQUIRE_EQ(internal::count_k_combinations(68, 34), max);
+
+    const std::size_t count_66_33 = 7219428434016265740ull;
+    const Idxs last = internal::nth_k_combination_idxs(66, 33, count_66_33 - 1);
+    REQUIRE_EQ(last, numbers<std::size_t>(33, 66));
+    const Idxs middle = internal::nth_k_combination_idxs(66, 33, 5000000000000000000ull);
+    REQUIRE_EQ(middle.size(), 33);
+    REQUIRE(is_strictly_sorted(middle));
+
+    const std::size_t count_64_32 = 1832624140942590534ull;
+    REQUIRE_FALSE(combination_state(64, 32, 1900000000000000000ull).is_valid());
+    REQUIRE_FALSE(combination_state(64, 32, count_64_32).is_valid());
+    combination_state state(64, 32, count_64_32 - 1);
+    REQUIRE(state.is_valid());
+    REQUIRE_EQ(state.idxs(), numbers<std::size_t>(32, 64));
+    REQUIRE_FALSE(state.next());
+}
+
 TEST_CASE("generate_test - iterate")
 {
     auto f = [](auto value) { return value * 2; };
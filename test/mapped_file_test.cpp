@@ -0,0 +1,108 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+const std::string filename = "mapped_file_test.txt";
+}
+
+TEST_CASE("mapped_file_test - mapped_file")
+{
+    using namespace fplus;
+    const std::string content = "first line\r\nsecond line\n\nERROR third line\n";
+    REQUIRE(write_binary_file(filename,
+        std::vector<std::uint8_t>(content.begin(), content.end()))());
+    {
+        const mapped_file file(filename, mapped_file_access::random);
+        REQUIRE(file.is_open());
+        REQUIRE_EQ(file.size(), content.size());
+        REQUIRE_EQ(std::string(file.begin(), file.end()), content);
+        REQUIRE_EQ(file[0], 'f');
+        const auto lines = split_lines_views(false, file.view());
+        REQUIRE_EQ(lines.size(), 3);
+        REQUIRE_EQ(std::string(lines[1].begin(), lines[1].end()), "second line");
+        const std::string token = "line";
+        REQUIRE_EQ(find_all_instances_of_token(make_span_view(token), file.view()),
+            std::vector<std::size_t>({ 6, 19, 37 }));
+        const std::string error = "ERROR";
+        REQUIRE_EQ(find_first_instance_of_token(make_span_view(error), file.view()),
+            just<std::size_t>(25));
+        const mapped_file copy = file;
+        REQUIRE_EQ(copy.data(), file.data());
+    }
+    {
+        const auto file = read_text_file_view(filename)();
+        REQUIRE(is_just(file));
+        REQUIRE_EQ(std::string(file.unsafe_get_just().begin(), file.unsafe_get_just().end()), content);
+        const auto bytes = read_binary_file_view(filename)();
+        REQUIRE(is_just(bytes));
+        REQUIRE_EQ(std::vector<std::uint8_t>(bytes.unsafe_get_just().begin(), bytes.unsafe_get_just().end()),
+            read_binary_file(filename)());
+    }
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("mapped_file_test - empty_and_missing_files")
+{
+    using namespace fplus;
+    REQUIRE(write_text_file(filename, "")());
+    const mapped_file empty(filename);
+    REQUIRE(empty.is_open());
+    REQUIRE(empty.empty());
+    REQUIRE(empty.view().empty());
+    std::remove(filename.c_str());
+
+    const mapped_file missing("does_not_exist.txt");
+    REQUIRE_FALSE(missing.is_open());
+    REQUIRE(missing.empty());
+    REQUIRE(is_nothing(read_text_file_view("does_not_exist.txt")()));
+    REQUIRE(is_nothing(read_binary_file_view("does_not_exist.txt")()));
+
+#if defined(__linux__)
+    // Reports a size of zero, so it is read instead of mapped.
+    const mapped_file proc_file("/proc/self/status");
+    REQUIRE(proc_file.is_open());
+    REQUIRE_FALSE(proc_file.empty());
+#endif
+}
+
+TEST_CASE("mapped_file_test - file_lines_parallelly")
+{
+    using namespace fplus;
+    std::string long_content;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        long_content += std::to_string(i) + (i % 7 == 0 ? "\r\n" : "\n");
+        if (i % 100 == 0)
+            long_content += i % 200 == 0 ? "\n" : "\r";
+    }
+    const std::vector<std::string> contents = {
+        "", "\n", "a", "a\n", "\r\n\r\n", "a\r\nb\rc\n\nd", long_content
+    };
+    const auto line_size = [](const std::string& line) { return line.size(); };
+    for (const auto& content : contents) {
+        REQUIRE(write_text_file_chunks(filename, std::vector<std::string>({ content }))());
+        for (const bool allow_empty : { false, true }) {
+            const auto lines = split_lines(allow_empty, content);
+            REQUIRE_EQ(transform_file_lines_parallelly(line_size, allow_empty, filename)(),
+                just(transform(line_size, lines)));
+            REQUIRE_EQ(transform_file_lines_parallelly(identity<std::string>, allow_empty, filename)(),
+                just(lines));
+            REQUIRE_EQ(fold_file_lines_parallelly([](std::size_t acc, const std::string&) {
+                return acc + 1;
+            },
+                           std::plus<std::size_t>(), std::size_t(0), allow_empty, filename)(),
+                just(lines.size()));
+        }
+    }
+    std::remove(filename.c_str());
+    REQUIRE(is_nothing(transform_file_lines_parallelly(line_size, true, "does_not_exist.txt")()));
+}
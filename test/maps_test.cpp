@@ -6,6 +6,10 @@
 
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace {
@@ -24,6 +28,19 @@ TEST_CASE("maps_test - transform_map_values")
     auto groupNameToMedianMap = transform_map_values(median<std::vector<int>>, stringIntPairsAsMapGrouped);
     typedef std::map<std::string, int> StringIntMap;
     REQUIRE_EQ(groupNameToMedianMap, StringIntMap({ { "a", 2 }, { "b", 6 } }));
+
+    typedef std::map<int, int, std::greater<int>> IntIntMapDesc;
+    const auto doubled = transform_map_values([](int x) { return 2.0 * x; },
+        IntIntMapDesc({ { 1, 1 }, { 2, 2 } }));
+    static_assert(std::is_same<decltype(doubled),
+                      const std::map<int, double, std::greater<int>>>::value,
+        "comparator not kept");
+    REQUIRE_EQ(doubled.begin()->first, 2);
+    const auto swapped = swap_keys_and_values(std::map<int, std::string, std::greater<int>>({ { 1, "a" }, { 2, "b" } }));
+    static_assert(std::is_same<decltype(swapped),
+                      const std::map<std::string, int, std::greater<std::string>>>::value,
+        "comparator not rebound");
+    REQUIRE_EQ(swapped.begin()->first, "b");
 }
 
 TEST_CASE("maps_test - choose")
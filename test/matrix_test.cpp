@@ -0,0 +1,204 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fplus/fplus.hpp>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+typedef std::vector<int> IntVector;
+typedef fplus::matrix<int> IntMatrix;
+typedef std::vector<std::size_t> IdxVector;
+
+IntMatrix numbered_matrix(std::size_t n_rows, std::size_t n_cols)
+{
+    IntMatrix m(n_rows, n_cols);
+    for (std::size_t row = 0; row < n_rows; ++row) {
+        for (std::size_t col = 0; col < n_cols; ++col) {
+            m(row, col) = static_cast<int>(row * 1000 + col);
+        }
+    }
+    return m;
+}
+
+struct NoDefault {
+    explicit NoDefault(int x)
+        : x_(x)
+    {
+    }
+    int x_;
+};
+bool operator==(const NoDefault& lhs, const NoDefault& rhs) { return lhs.x_ == rhs.x_; }
+}
+
+TEST_CASE("matrix_test - construction_and_access")
+{
+    using namespace fplus;
+    const IntMatrix m(2, 3, IntVector({ 1, 2, 3, 4, 5, 6 }));
+    REQUIRE_EQ(m.rows(), 2);
+    REQUIRE_EQ(m.cols(), 3);
+    REQUIRE_EQ(m.size(), 6);
+    REQUIRE_FALSE(m.is_square());
+    REQUIRE_EQ(m(1, 0), 4);
+    REQUIRE_EQ(m.data()[1 * 3 + 2], m(1, 2));
+    REQUIRE_EQ(IntVector(m.begin(), m.end()), IntVector({ 1, 2, 3, 4, 5, 6 }));
+    REQUIRE_EQ(IntVector(m.row(1).begin(), m.row(1).end()), IntVector({ 4, 5, 6 }));
+    REQUIRE_EQ(IntMatrix(2, 2, 7), IntMatrix(2, 2, IntVector({ 7, 7, 7, 7 })));
+    REQUIRE(IntMatrix().empty());
+    REQUIRE(IntMatrix(2, 3) != IntMatrix(3, 2));
+    IntMatrix n(2, 2);
+    n.row(1)[0] = 3;
+    REQUIRE_EQ(n(1, 0), 3);
+    REQUIRE_EQ(sum(m), 21);
+}
+
+TEST_CASE("matrix_test - transpose")
+{
+    using namespace fplus;
+    REQUIRE_EQ(transpose(IntMatrix(2, 3, IntVector({ 1, 2, 3, 4, 5, 6 }))),
+        IntMatrix(3, 2, IntVector({ 1, 4, 2, 5, 3, 6 })));
+    REQUIRE_EQ(transpose(IntMatrix()), IntMatrix());
+    REQUIRE_EQ(transpose(IntMatrix(0, 3)), IntMatrix(3, 0));
+    for (const auto& shape : std::vector<std::pair<std::size_t, std::size_t>>({ { 70, 45 }, { 33, 100 }, { 65, 65 }, { 1, 1 } })) {
+        const auto m = numbered_matrix(shape.first, shape.second);
+        const auto t = transpose(m);
+        REQUIRE_EQ(t.rows(), m.cols());
+        REQUIRE_EQ(t.cols(), m.rows());
+        bool all_equal = true;
+        for (std::size_t row = 0; row < m.rows(); ++row) {
+            for (std::size_t col = 0; col < m.cols(); ++col) {
+                all_equal = all_equal && t(col, row) == m(row, col);
+            }
+        }
+        REQUIRE(all_equal);
+        REQUIRE_EQ(transpose(t), m);
+    }
+    const std::vector<NoDefault> no_defaults = { NoDefault(1), NoDefault(2) };
+    REQUIRE_EQ(transpose(matrix<NoDefault>(1, 2, no_defaults)),
+        matrix<NoDefault>(2, 1, no_defaults));
+}
+
+TEST_CASE("matrix_test - transpose_in_place")
+{
+    using namespace fplus;
+    for (std::size_t n : IdxVector({ 0, 1, 2, 31, 32, 33, 100 })) {
+        const auto m = numbered_matrix(n, n);
+        auto copy = m;
+        const auto data = copy.data();
+        const auto t = transpose(std::move(copy));
+        REQUIRE_EQ(t, transpose(m));
+        if (n > 0) {
+            REQUIRE_EQ(t.data(), data);
+        }
+    }
+    auto m = numbered_matrix(3, 5);
+    REQUIRE_EQ(transpose(std::move(m)), transpose(numbered_matrix(3, 5)));
+    matrix<std::string> strs(2, 2, std::vector<std::string>({ "a", "b", "c", "d" }));
+    strs.transpose_square_in_place();
+    REQUIRE_EQ(strs, matrix<std::string>(2, 2, std::vector<std::string>({ "a", "c", "b", "d" })));
+}
+
+TEST_CASE("matrix_test - aligned_storage")
+{
+    using namespace fplus;
+    for (std::size_t n : IdxVector({ 1, 3, 100 })) {
+        const matrix<char> m(n, n);
+        REQUIRE_EQ(reinterpret_cast<std::uintptr_t>(m.data()) % matrix<char>::alignment, 0);
+    }
+    std::vector<double, aligned_allocator<double, 32>> xs(5, 1.5);
+    REQUIRE_EQ(reinterpret_cast<std::uintptr_t>(xs.data()) % 32, 0);
+    const auto ys = transform([](double x) { return static_cast<int>(2 * x); }, xs);
+    static_assert(std::is_same<std::decay_t<decltype(ys)>,
+                      std::vector<int, aligned_allocator<int, 32>>>::value,
+        "alignment not kept");
+    REQUIRE_EQ(IntVector(ys.begin(), ys.end()), IntVector({ 3, 3, 3, 3, 3 }));
+}
+
+TEST_CASE("matrix_test - transform_and_zip_with")
+{
+    using namespace fplus;
+    const IntMatrix m(2, 3, IntVector({ 1, 2, 3, 4, 5, 6 }));
+    REQUIRE_EQ(transform([](int x) { return 2 * x; }, m),
+        IntMatrix(2, 3, IntVector({ 2, 4, 6, 8, 10, 12 })));
+    IntMatrix mutable_m = m;
+    const auto halves = transform([](int x) { return x / 2.0; }, mutable_m);
+    REQUIRE_EQ(halves.rows(), 2);
+    REQUIRE_EQ(halves(1, 2), doctest::Approx(3.0));
+    REQUIRE_EQ(transform([](int x) { return NoDefault(x); }, m)(1, 0), NoDefault(4));
+    REQUIRE_EQ(zip_with(std::minus<int>(), m, IntMatrix(2, 3, 1)),
+        IntMatrix(2, 3, IntVector({ 0, 1, 2, 3, 4, 5 })));
+    REQUIRE_EQ(zip_with([](int x, double y) { return x * y; }, m, halves)(1, 1),
+        doctest::Approx(12.5));
+    REQUIRE_EQ(transform([](int x) { return x; }, IntMatrix()), IntMatrix());
+    auto copy = m;
+    const auto data = copy.data();
+    const auto doubled = transform([](int x) { return 2 * x; }, std::move(copy));
+    REQUIRE_EQ(doubled, transform([](int x) { return 2 * x; }, m));
+    REQUIRE_EQ(doubled.data(), data);
+    REQUIRE_EQ(transform([](int x) { return x / 2.0; }, IntMatrix(1, 1, 3))(0, 0),
+        doctest::Approx(1.5));
+}
+
+TEST_CASE("matrix_test - reductions")
+{
+    using namespace fplus;
+    const IntMatrix m(2, 3, IntVector({ 1, 2, 3, 4, 5, 6 }));
+    REQUIRE_EQ(fold_left(std::minus<int>(), 0, m), -21);
+    REQUIRE_EQ(reduce(std::plus<int>(), 0, m), 21);
+    REQUIRE_EQ(reduce(std::plus<int>(), 0, numbered_matrix(5, 7)), 7 * (0 + 1 + 2 + 3 + 4) * 1000 + 5 * 21);
+    REQUIRE_EQ(reduce_rows(std::plus<int>(), 0, m), IntVector({ 6, 15 }));
+    REQUIRE_EQ(reduce_cols(std::plus<int>(), 0, m), IntVector({ 5, 7, 9 }));
+    REQUIRE_EQ(reduce_rows(std::plus<int>(), 0, IntMatrix(2, 0)), IntVector({ 0, 0 }));
+    REQUIRE_EQ(reduce_cols(std::plus<int>(), 0, IntMatrix(0, 2)), IntVector({ 0, 0 }));
+    const auto big = numbered_matrix(3, 21);
+    REQUIRE_EQ(reduce_rows(std::plus<int>(), 0, big), IntVector({ 210, 21210, 42210 }));
+    REQUIRE_EQ(reduce_cols([](int x, int y) { return std::max(x, y); }, 0, big)[20], 2020);
+
+    // init is applied only once, also when the lanes are used.
+    const IntMatrix ones(4, 4, 1);
+    REQUIRE_EQ(reduce(std::plus<int>(), 10, ones), reduce(std::plus<int>(), 10, IntVector(16, 1)));
+    REQUIRE_EQ(reduce(std::plus<>(), 10, ones), 26);
+    REQUIRE_EQ(reduce_rows(std::plus<int>(), 10, IntMatrix(2, 17, 1)), IntVector({ 27, 27 }));
+    REQUIRE_EQ(reduce(std::multiplies<int>(), 3, IntMatrix(3, 3, 2)), 3 * 512);
+
+    // Other functions are applied strictly from left to right.
+    REQUIRE_EQ(reduce(std::minus<int>(), 100, big), 100 - sum(big));
+    const auto letters = transform([](int x) { return std::string(1, static_cast<char>('a' + x % 1000 + x / 1000 * 8)); },
+        numbered_matrix(2, 8));
+    REQUIRE_EQ(reduce(std::plus<std::string>(), std::string(">"), letters), std::string(">abcdefghijklmnop"));
+    REQUIRE_EQ(reduce_rows(std::plus<std::string>(), std::string(">"), letters),
+        std::vector<std::string>({ ">abcdefgh", ">ijklmnop" }));
+    REQUIRE_EQ(inner_product(0, m, m), 91);
+    REQUIRE_EQ(inner_product(9, big, IntMatrix(3, 21, 1)), 9 + sum(big));
+    REQUIRE_EQ(inner_product(0.5, m, m), doctest::Approx(91.5));
+    const auto ms = mean_stddev<double>(IntMatrix(2, 2, IntVector({ 1, 3, 7, 4 })));
+    REQUIRE_EQ(ms.first, doctest::Approx(3.75));
+    REQUIRE_EQ(ms.second, doctest::Approx(std::sqrt(4.6875)));
+    const auto big_ms = mean_stddev<double>(big);
+    const auto expected = mean_stddev<double>(IntVector(big.begin(), big.end()));
+    REQUIRE_EQ(big_ms.first, doctest::Approx(expected.first));
+    REQUIRE_EQ(big_ms.second, doctest::Approx(expected.second));
+}
+
+TEST_CASE("matrix_test - rows_conversion")
+{
+    using namespace fplus;
+    const std::vector<IntVector> rows = { { 1, 2, 3 }, { 4, 5, 6 } };
+    const auto m = matrix_from_rows(rows);
+    REQUIRE_EQ(m, IntMatrix(2, 3, IntVector({ 1, 2, 3, 4, 5, 6 })));
+    REQUIRE_EQ(matrix_to_rows(m), rows);
+    REQUIRE_EQ(matrix_to_rows(transpose(m)), transpose(rows));
+    REQUIRE_EQ(matrix_from_rows(std::vector<IntVector>()), IntMatrix());
+    REQUIRE(matrix_to_rows(IntMatrix()).empty());
+    REQUIRE_EQ(fwd::matrix_to_rows()(fwd::matrix_from_rows()(rows)), rows);
+    REQUIRE_EQ(fwd::reduce_cols(std::plus<int>(), 0)(m), IntVector({ 5, 7, 9 }));
+}
@@ -188,4 +188,17 @@ TEST_CASE("pairs_test - zip_repeat")
     REQUIRE_EQ(zip_repeat(label, IntVector { 0, 1 }), zip(label, IntVector { 0, 1 }));
     REQUIRE_EQ(zip_repeat(label, IntVector { 0, 1, 2 }), expected);
     REQUIRE_EQ(zip_repeat(IntVector { 0, 1, 2 }, label), transform(fwd::swap_pair_elems(), expected));
-}
\ No newline at end of file
+}
+
+TEST_CASE("pairs_test - zip_into")
+{
+    using namespace fplus;
+    IntPairs ys = { { 7, 7 } };
+    zip_into(IntVector({ 1, 2, 3 }), IntVector({ 5, 6 }), ys);
+    REQUIRE_EQ(ys, IntPairs({ { 1, 5 }, { 2, 6 } }));
+    IntVector zs = { 7 };
+    zip_with_into(std::plus<int>(), IntList({ 1, 2 }), IntVector({ 5, 6, 7 }), zs);
+    REQUIRE_EQ(zs, IntVector({ 6, 8 }));
+    zip_with_into(std::plus<int>(), IntVector({ 1 }), IntVector({ 5 }), std::back_inserter(zs));
+    REQUIRE_EQ(zs, IntVector({ 6, 8, 6 }));
+}
@@ -0,0 +1,171 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+
+#include <list>
+#include <type_traits>
+
+namespace {
+typedef std::pmr::vector<int> IntVector;
+typedef std::pmr::list<int> IntList;
+typedef std::vector<int> StdIntVector;
+
+auto is_even_int = [](int x) { return x % 2 == 0; };
+auto squared_int = [](int x) { return x * x; };
+
+// Allocating more than the buffer or from elsewhere throws.
+struct test_resource {
+    test_resource()
+        : buffer_()
+        , resource_(buffer_, sizeof(buffer_), std::pmr::null_memory_resource())
+    {
+    }
+    std::pmr::memory_resource* get() { return &resource_; }
+    unsigned char buffer_[1 << 14];
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
+template <typename Container>
+bool uses(std::pmr::memory_resource* resource, const Container& xs)
+{
+    return *xs.get_allocator().resource() == *resource;
+}
+}
+
+TEST_CASE("pmr_test - same_cont_new_t")
+{
+    using namespace fplus;
+    static_assert(std::is_same<
+                      internal::same_cont_new_t<IntVector, std::string>::type,
+                      std::pmr::vector<std::string>>::value,
+        "pmr vector not rebound");
+    static_assert(std::is_same<
+                      internal::same_cont_new_t<std::pmr::set<int>, double>::type,
+                      std::pmr::set<double>>::value,
+        "pmr set not rebound");
+    static_assert(std::is_same<
+                      internal::same_cont_new_t<std::pmr::string, int>::type::allocator_type,
+                      std::pmr::polymorphic_allocator<int>>::value,
+        "pmr string not rebound");
+    static_assert(std::is_same<
+                      internal::SameMapTypeNewTypes<std::pmr::map<int, int>, int, std::string>::type,
+                      std::pmr::map<int, std::string>>::value,
+        "pmr map not rebound");
+    static_assert(std::is_same<
+                      internal::SameMapTypeNewTypes<std::pmr::unordered_map<int, int>, int, std::string>::type,
+                      std::pmr::unordered_map<int, std::string>>::value,
+        "pmr unordered_map not rebound");
+}
+
+TEST_CASE("pmr_test - transform")
+{
+    using namespace fplus;
+    test_resource resource;
+    const IntVector xs({ 1, 2, 3 }, resource.get());
+    const auto ys = transform(squared_int, xs);
+    REQUIRE_EQ(StdIntVector(ys.begin(), ys.end()), StdIntVector({ 1, 4, 9 }));
+    REQUIRE(uses(resource.get(), ys));
+    const auto strs = transform([](int x) { return std::to_string(x); }, xs);
+    static_assert(std::is_same<std::decay_t<decltype(strs)>,
+                      std::pmr::vector<std::string>>::value,
+        "wrong result type");
+    REQUIRE_EQ(strs.size(), 3);
+    REQUIRE(uses(resource.get(), strs));
+    const auto converted = transform_convert<std::pmr::vector<double>>(
+        [](int x) { return 0.5 * x; }, xs);
+    REQUIRE(uses(resource.get(), converted));
+}
+
+TEST_CASE("pmr_test - keep_if")
+{
+    using namespace fplus;
+    test_resource resource;
+    const IntVector xs({ 1, 2, 3, 4 }, resource.get());
+    const auto ys = keep_if(is_even_int, xs);
+    REQUIRE_EQ(StdIntVector(ys.begin(), ys.end()), StdIntVector({ 2, 4 }));
+    REQUIRE(uses(resource.get(), ys));
+    REQUIRE(uses(resource.get(), drop_if(is_even_int, xs)));
+    REQUIRE(uses(resource.get(), keep_by_idx([](std::size_t idx) { return idx < 2; }, xs)));
+}
+
+TEST_CASE("pmr_test - sort")
+{
+    using namespace fplus;
+    test_resource resource;
+    const IntVector xs({ 3, 1, 2 }, resource.get());
+    const auto ys = sort(xs);
+    REQUIRE_EQ(StdIntVector(ys.begin(), ys.end()), StdIntVector({ 1, 2, 3 }));
+    REQUIRE(uses(resource.get(), ys));
+    REQUIRE(uses(resource.get(), stable_sort(xs)));
+    REQUIRE(uses(resource.get(), unique(xs)));
+    const IntList zs({ 3, 1, 2 }, resource.get());
+    const auto sorted_zs = sort(zs);
+    REQUIRE_EQ(StdIntVector(sorted_zs.begin(), sorted_zs.end()), StdIntVector({ 1, 2, 3 }));
+    REQUIRE(uses(resource.get(), sorted_zs));
+}
+
+TEST_CASE("pmr_test - split_and_group")
+{
+    using namespace fplus;
+    test_resource resource;
+    const IntVector xs({ 1, 2, 2, 0, 3, 0, 4 }, resource.get());
+    const auto splitted = split(0, true, xs);
+    REQUIRE_EQ(splitted.size(), 3);
+    REQUIRE_EQ(StdIntVector(splitted[0].begin(), splitted[0].end()), StdIntVector({ 1, 2, 2 }));
+    for (const auto& part : splitted) {
+        REQUIRE(uses(resource.get(), part));
+    }
+    for (const auto& part : split_every(3, xs)) {
+        REQUIRE(uses(resource.get(), part));
+    }
+    for (const auto& part : split_by_keep_separators(is_even_int, xs)) {
+        REQUIRE(uses(resource.get(), part));
+    }
+    const auto halves = split_at_idx(2, xs);
+    REQUIRE(uses(resource.get(), halves.first));
+    REQUIRE(uses(resource.get(), halves.second));
+    const auto partitioned = partition(is_even_int, xs);
+    REQUIRE(uses(resource.get(), partitioned.first));
+    REQUIRE(uses(resource.get(), partitioned.second));
+    const auto groups = group(xs);
+    REQUIRE_EQ(groups.size(), 6);
+    REQUIRE_EQ(StdIntVector(groups[1].begin(), groups[1].end()), StdIntVector({ 2, 2 }));
+    for (const auto& g : groups) {
+        REQUIRE(uses(resource.get(), g));
+    }
+    for (const auto& g : group_globally(xs)) {
+        REQUIRE(uses(resource.get(), g));
+    }
+}
+
+TEST_CASE("pmr_test - concat")
+{
+    using namespace fplus;
+    test_resource resource;
+    const IntVector xs({ 1, 2 }, resource.get());
+    const IntVector ys({ 3 }, resource.get());
+    std::pmr::vector<IntVector> xss(resource.get());
+    xss.push_back(xs);
+    xss.push_back(ys);
+    const auto zs = concat(xss);
+    REQUIRE_EQ(StdIntVector(zs.begin(), zs.end()), StdIntVector({ 1, 2, 3 }));
+    REQUIRE(uses(resource.get(), zs));
+    REQUIRE(concat(std::vector<IntVector>()).empty());
+}
+
+#endif
@@ -39,3 +39,83 @@ TEST_CASE("read_test - read_value_result")
     REQUIRE(is_error(read_value_result<int>("twenty")));
     REQUIRE(is_error(read_value_result<int>("3 thousand")));
 }
+
+TEST_CASE("read_test - read_value_keeps_lenient_parsing")
+{
+    using namespace fplus;
+    REQUIRE_EQ(read_value<int>(" 42"), just<int>(42));
+    REQUIRE_EQ(read_value<int>("+42"), just<int>(42));
+    REQUIRE_EQ(read_value<unsigned int>("-1"), just<unsigned int>(static_cast<unsigned int>(-1)));
+    REQUIRE_EQ(read_value<int>("99999999999999999999"), nothing<int>());
+    REQUIRE_EQ(read_value<double>("0.25"), just<double>(0.25));
+    REQUIRE_EQ(read_value<double>("1e3"), just<double>(1000.0));
+    REQUIRE_EQ(read_value<double>("1e3x"), nothing<double>());
+}
+
+namespace {
+// With C++17, read_value_result tries std::from_chars first,
+// which must not change the results of the std::sto* functions.
+template <typename T>
+void require_same_as_sto(const std::vector<std::string>& strs)
+{
+    for (const auto& str : strs) {
+        const auto expected = fplus::internal::read_value_from_string<T>(str);
+        const auto parsed = fplus::read_value_result<T>(str);
+        REQUIRE_EQ(fplus::is_ok(parsed), fplus::is_ok(expected));
+        if (fplus::is_ok(parsed)) {
+            REQUIRE_EQ(fplus::show(parsed.unsafe_get_ok()), fplus::show(expected.unsafe_get_ok()));
+        }
+    }
+}
+}
+
+TEST_CASE("read_test - read_value_result_matches_sto")
+{
+    const std::vector<std::string> integers = { "42", "+42", " 42", "42 ", "-0", "007",
+        "0x10", "", "-", "+", "2147483647", "2147483648", "-2147483649",
+        "4294967296", "18446744073709551615", "18446744073709551616",
+        "99999999999999999999", "-1" };
+    require_same_as_sto<int>(integers);
+    require_same_as_sto<long long>(integers);
+    require_same_as_sto<unsigned int>(integers);
+    require_same_as_sto<unsigned long long>(integers);
+
+    const std::vector<std::string> floats = { "0.25", "+0.25", " 0.25", ".5", "5.",
+        "1e3", "1E+3", "1e", "0x1p3", "0X1P-2", "inf", "-inf", "INF", "infinity",
+        "nan", "1e400", "-1e400", "1e-40", "1e-310", "1e-400", "3.4e39", "1,5" };
+    require_same_as_sto<float>(floats);
+    require_same_as_sto<double>(floats);
+    require_same_as_sto<long double>(floats);
+}
+
+TEST_CASE("read_test - read_value_view")
+{
+    using namespace fplus;
+    const std::string line = "12,-3,0.5";
+    const auto fields = split_by_views(is_equal_to(','), true, line);
+    REQUIRE_EQ(read_value_view<int>(fields[0]), just<int>(12));
+    REQUIRE_EQ(read_value_view<int>(fields[1]), just<int>(-3));
+    REQUIRE_EQ(read_value_view<double>(fields[2]), just<double>(0.5));
+    REQUIRE_EQ(read_value_view<int>(fields[2]), nothing<int>());
+    REQUIRE_EQ(read_value_view<int>(std::string("42")), just<int>(42));
+    REQUIRE_EQ(read_value_view<std::size_t>(std::string("42")), just<std::size_t>(42));
+    REQUIRE_EQ(read_value_view<std::string>(fields[1]), just<std::string>("-3"));
+    REQUIRE_EQ(read_value_view<int>(std::string("")), nothing<int>());
+    REQUIRE_EQ(read_value_view<int>(std::string("3 thousand")), nothing<int>());
+    REQUIRE(is_error(read_value_view_result<int>(std::string("99999999999999999999"))));
+}
+
+TEST_CASE("read_test - read_values")
+{
+    using namespace fplus;
+    const std::vector<std::string> strs = { "1", "2", "3" };
+    REQUIRE_EQ(read_values<int>(strs), just(std::vector<int>({ 1, 2, 3 })));
+    REQUIRE_EQ(read_values<double>(strs), just(std::vector<double>({ 1, 2, 3 })));
+    REQUIRE_EQ(read_values<int>(std::vector<std::string>()), just(std::vector<int>()));
+    const std::vector<std::string> broken = { "1", "x", "3" };
+    REQUIRE_EQ(read_values<int>(broken), nothing<std::vector<int>>());
+    REQUIRE_EQ(read_values_result<int>(broken).unsafe_get_error().substr(0, 3), "1: ");
+    const std::string line = "4 5 6";
+    REQUIRE_EQ(read_values<int>(split_by_views(is_equal_to(' '), false, line)),
+        just(std::vector<int>({ 4, 5, 6 })));
+}
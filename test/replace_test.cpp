@@ -6,6 +6,7 @@
 
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -48,3 +49,42 @@ TEST_CASE("replace_test - replace_tokens")
     auto result = fplus::replace_tokens(source, dest, input);
     REQUIRE_EQ(result, std::string("oh, hihiha!"));
 }
+
+TEST_CASE("replace_test - replace_tokens_multi")
+{
+    typedef std::pair<std::string, std::string> StringPair;
+    const std::vector<StringPair> mapping = { { "ha", "hi" }, { "oh", "ah" } };
+    REQUIRE_EQ(fplus::replace_tokens_multi(mapping, std::string("oh, hahaha!")),
+        std::string("ah, hihihi!"));
+
+    // Leftmost, then longest match wins.
+    const std::map<std::string, std::string> overlapping = {
+        { "a", "1" }, { "ab", "2" }, { "bc", "3" }, { "", "x" }
+    };
+    REQUIRE_EQ(fplus::replace_tokens_multi(overlapping, std::string("abcabc")),
+        std::string("2c2c"));
+    REQUIRE_EQ(fplus::replace_tokens_multi(overlapping, std::string("bca")),
+        std::string("31"));
+
+    const fplus::token_replacer<std::string> escape_html(
+        { { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" } });
+    REQUIRE_EQ(escape_html(std::string("a<b && c>d")),
+        std::string("a&lt;b &amp;&amp; c&gt;d"));
+    REQUIRE_EQ(escape_html(std::string()), std::string());
+
+    const std::vector<std::pair<std::vector<int>, std::vector<int>>> int_mapping = {
+        { { 1, 2 }, {} }, { { 3 }, { 4, 4 } }
+    };
+    REQUIRE_EQ(fplus::replace_tokens_multi(int_mapping, std::vector<int>({ 1, 2, 3, 1, 3 })),
+        std::vector<int>({ 4, 4, 1, 4, 4 }));
+}
+
+TEST_CASE("replace_test - replace_tokens_multi_matches_replace_tokens")
+{
+    const std::string input = "oh, hahaha! hahahaha";
+    for (const std::string token : { "a", "ha", "haha", "h!", "oh, hahaha! hahahaha" }) {
+        const std::vector<std::pair<std::string, std::string>> mapping = { { token, "_" } };
+        REQUIRE_EQ(fplus::replace_tokens_multi(mapping, input),
+            fplus::replace_tokens(token, std::string("_"), input));
+    }
+}
@@ -5,7 +5,9 @@
 //  http://www.boost.org/LICENSE_1_0.txt)
 
 #include <doctest/doctest.h>
+#include <deque>
 #include <fplus/fplus.hpp>
+#include <list>
 #include <vector>
 
 namespace {
@@ -13,6 +15,38 @@ bool is_even(int value)
 {
     return value % 2 == 0;
 }
+
+template <typename Container>
+std::vector<std::size_t> find_all_instances_of_token_naive(
+    const Container& token, const Container& xs)
+{
+    std::vector<std::size_t> result;
+    for (std::size_t idx = 0; idx + fplus::size_of_cont(token) <= fplus::size_of_cont(xs); ++idx) {
+        if (fplus::get_segment(idx, idx + fplus::size_of_cont(token), xs) == token) {
+            result.push_back(idx);
+        }
+    }
+    return result;
+}
+
+template <typename Container>
+void check_token_search(const std::string& token_str, const std::string& xs_str)
+{
+    const Container token(std::begin(token_str), std::end(token_str));
+    const Container xs(std::begin(xs_str), std::end(xs_str));
+    const auto expected = find_all_instances_of_token_naive(token, xs);
+    std::vector<std::size_t> expected_non_overlapping;
+    for (const auto idx : expected) {
+        if (expected_non_overlapping.empty() || expected_non_overlapping.back() + token.size() <= idx) {
+            expected_non_overlapping.push_back(idx);
+        }
+    }
+    REQUIRE_EQ(fplus::find_all_instances_of_token(token, xs), expected);
+    REQUIRE_EQ(fplus::find_first_instance_of_token(token, xs),
+        expected.empty() ? fplus::nothing<std::size_t>() : fplus::just(expected.front()));
+    REQUIRE_EQ(fplus::find_all_instances_of_token_non_overlapping(token, xs),
+        expected_non_overlapping);
+}
 }
 
 TEST_CASE("search_test - find_first_by")
@@ -182,3 +216,90 @@ TEST_CASE("search_test - find_first_instance_of_token_oversized_token")
     auto result = fplus::find_first_instance_of_token(token, input);
     REQUIRE_EQ(result, fplus::nothing<size_t>());
 }
+
+TEST_CASE("search_test - find_all_instances_of_token_empty_token")
+{
+    const std::string input = "abc";
+    REQUIRE_EQ(fplus::find_all_instances_of_token(std::string(), input),
+        std::vector<std::size_t>({ 0, 1, 2, 3 }));
+    REQUIRE_EQ(fplus::find_all_instances_of_token_non_overlapping(std::string(), input),
+        std::vector<std::size_t>({ 0, 1, 2, 3 }));
+    REQUIRE_EQ(fplus::find_first_instance_of_token(std::string(), input),
+        fplus::just<size_t>(0));
+}
+
+TEST_CASE("search_test - find_all_instances_of_token_containers")
+{
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        { "a", "banana" },
+        { "ana", "banana" },
+        { "banana", "banana" },
+        { "nab", "banana" },
+        { "aa", "aaaaa" },
+        { "abcab", "abcabcabcababcab" },
+        { "\xff\x01", "\x01\xff\x01\xff\xff\x01" },
+        { "xyz", "" }
+    };
+    for (const auto& c : cases) {
+        check_token_search<std::string>(c.first, c.second);
+        check_token_search<std::vector<char>>(c.first, c.second);
+        check_token_search<std::vector<unsigned char>>(c.first, c.second);
+        check_token_search<std::vector<int>>(c.first, c.second);
+        check_token_search<std::deque<char>>(c.first, c.second);
+        check_token_search<std::list<char>>(c.first, c.second);
+    }
+}
+
+TEST_CASE("search_test - find_all_instances_of_token_long_input")
+{
+    const auto line = std::string("2024-01-01 INFO request handled\n");
+    const auto log = fplus::repeat(1000, line)
+        + std::string("2024-01-01 ERROR request failed\n");
+    REQUIRE_EQ(fplus::find_all_instances_of_token(std::string("ERROR"), log),
+        std::vector<std::size_t>({ 1000 * line.size() + 11 }));
+    REQUIRE_EQ(fplus::find_all_instances_of_token(std::string("INFO"), log).size(),
+        1000);
+    REQUIRE_EQ(fplus::split_by_token(std::string("\n"), false, log).size(),
+        1001);
+}
+
+TEST_CASE("search_test - find_all_instances_of_tokens")
+{
+    typedef std::pair<std::size_t, std::size_t> Match;
+    typedef std::vector<Match> Matches;
+    const std::vector<std::string> tokens = { "ha", "oh" };
+    REQUIRE_EQ(fplus::find_all_instances_of_tokens(tokens, std::string("oh, haha!")),
+        Matches({ { 1, 0 }, { 0, 4 }, { 0, 6 } }));
+
+    const fplus::token_automaton<std::string> automaton({ "he", "she", "hers", "his", "", "he" });
+    REQUIRE_EQ(automaton.size(), 6);
+    REQUIRE_EQ(automaton.find_all(std::string("ushers")),
+        Matches({ { 1, 1 }, { 0, 2 }, { 2, 2 }, { 5, 2 } }));
+    REQUIRE_EQ(automaton.find_all(std::string("ahishers")),
+        Matches({ { 3, 1 }, { 1, 3 }, { 0, 4 }, { 2, 4 }, { 5, 4 } }));
+    REQUIRE(automaton.find_all(std::string()).empty());
+}
+
+TEST_CASE("search_test - find_all_instances_of_tokens_matches_single_token_search")
+{
+    const std::string input = "abababcabcababcbabcaaab";
+    const std::vector<std::string> tokens = { "ab", "abc", "bab", "a", "caa", "cab", "b" };
+    std::vector<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        for (const auto idx : fplus::find_all_instances_of_token(tokens[i], input)) {
+            expected.push_back({ i, idx });
+        }
+    }
+    expected = fplus::sort_on([](const std::pair<std::size_t, std::size_t>& m) {
+        return std::make_pair(m.second, m.first);
+    },
+        expected);
+    REQUIRE_EQ(fplus::find_all_instances_of_tokens(tokens, input), expected);
+
+    // element type only less-than comparable
+    typedef std::vector<std::pair<int, int>> IntPairs;
+    const std::vector<IntPairs> pair_tokens = { { { 1, 2 }, { 3, 4 } }, { { 3, 4 } } };
+    const IntPairs pairs = { { 3, 4 }, { 1, 2 }, { 3, 4 } };
+    REQUIRE_EQ(fplus::find_all_instances_of_tokens(pair_tokens, pairs),
+        std::vector<std::pair<std::size_t, std::size_t>>({ { 1, 0 }, { 0, 1 }, { 1, 2 } }));
+}
@@ -6,6 +6,9 @@
 
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <limits>
+#include <random>
+#include <sstream>
 
 namespace {
 typedef std::vector<int> IntVector;
@@ -25,6 +28,16 @@ StringSet stringSet = { "foo", "bar" };
 std::string stringSetShown("[bar, foo]");
 }
 
+namespace show_test_adl {
+struct point {
+    int x;
+};
+std::string show(const point& p)
+{
+    return "P" + std::to_string(p.x);
+}
+}
+
 TEST_CASE("show_test - show")
 {
     using namespace fplus;
@@ -51,6 +64,13 @@ TEST_CASE("show_test - show")
     REQUIRE_EQ(show<int>(1), "1");
 
     REQUIRE_EQ(show(std::vector<std::vector<int>>({ { 1, 2, 3 }, { 4, 5, 6 } })), "[[1, 2, 3], [4, 5, 6]]");
+
+    // Overloads of show for the elements are found by ADL.
+    const std::vector<show_test_adl::point> points = { { 1 }, { 2 } };
+    REQUIRE_EQ(show_cont(points), "[P1, P2]");
+    REQUIRE_EQ(fplus::show(points), "[P1, P2]");
+    REQUIRE_EQ(fplus::show(std::make_pair(show_test_adl::point { 3 }, 4)), "(P3, 4)");
+    REQUIRE_EQ(fplus::show(std::vector<std::vector<show_test_adl::point>>({ points })), "[[P1, P2]]");
 }
 
 TEST_CASE("show_test - show_float")
@@ -90,3 +110,74 @@ TEST_CASE("show_test - show_float")
     std::list<std::string> lt1 = stream(t1);
     REQUIRE_EQ(show_cont(lt1), "[10, Test, 3.14]");
 }
+
+TEST_CASE("show_test - show_into")
+{
+    using namespace fplus;
+    std::string out = "values: ";
+    show_into(out, 42);
+    out += ' ';
+    show_into(out, xs);
+    out += ' ';
+    show_into(out, std::make_pair(std::string("pi"), 3.14159));
+    REQUIRE_EQ(out, "values: 42 [1, 2, 2, 3, 2] (pi, 3.14159)");
+
+    REQUIRE_EQ(show('x'), "x");
+    REQUIRE_EQ(show(true), "1");
+    REQUIRE_EQ(show(-7L), "-7");
+    REQUIRE_EQ(show(std::vector<double>({ 0.5, -2.0, 1e20 })), "[0.5, -2, 1e+20]");
+    REQUIRE_EQ(show<std::vector<int>>(xs), xsShown);
+    REQUIRE_EQ(show_cont_with_frame(" => ", "{", "}", std::vector<int>({ 1, 2, 3 })), "{1 => 2 => 3}");
+    REQUIRE_EQ(show_cont_with_frame_and_newlines(",", "(", ")", std::vector<int>(), 2), "()");
+    REQUIRE_EQ(show_cont_with_frame_and_newlines(", ", "{", "}",
+                   std::vector<std::string>({ "a", "bc", "", "d" }), 3),
+        "{a, bc, , \n d}");
+    REQUIRE_EQ(show_cont(std::vector<std::vector<std::string>>({ { "a" }, {}, { "b", "c" } })),
+        "[[a], [], [b, c]]");
+}
+
+TEST_CASE("show_test - show_matches_streams")
+{
+    using namespace fplus;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> mantissa_dist(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent_dist(-40, 40);
+    const auto streamed = [](const auto& x) {
+        std::ostringstream ss;
+        ss << x;
+        return ss.str();
+    };
+    const auto streamed_fixed = [](int precision, double x) {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(precision) << x;
+        return ss.str();
+    };
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const double x = mantissa_dist(gen) * std::pow(10.0, exponent_dist(gen));
+        REQUIRE_EQ(show(x), streamed(x));
+        REQUIRE_EQ(show(static_cast<float>(x)), streamed(static_cast<float>(x)));
+        REQUIRE_EQ(show(static_cast<long long>(x)), streamed(static_cast<long long>(x)));
+        const int precision = static_cast<int>(i % 8);
+        REQUIRE_EQ(show_float<double>(0, static_cast<std::size_t>(precision), std::abs(x)),
+            streamed_fixed(precision, std::abs(x)));
+    }
+    REQUIRE_EQ(show(std::numeric_limits<double>::infinity()), "inf");
+    REQUIRE_EQ(show(std::numeric_limits<int>::min()), streamed(std::numeric_limits<int>::min()));
+    REQUIRE_EQ(show(std::numeric_limits<unsigned long long>::max()),
+        streamed(std::numeric_limits<unsigned long long>::max()));
+    REQUIRE_EQ(show_float<double>(2, 1, 1e300).size(), 303);
+    REQUIRE_EQ(show_float<int>(3, 2, -7), "-00007");
+}
+
+TEST_CASE("show_test - show_round_trip")
+{
+    using namespace fplus;
+    REQUIRE_EQ(show_round_trip(0.5), "0.5");
+    REQUIRE_EQ(show_round_trip(-2.0f).substr(0, 2), "-2");
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const double x = dist(gen);
+        REQUIRE_EQ(read_value_unsafe<double>(show_round_trip(x)), x);
+    }
+}
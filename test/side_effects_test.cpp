@@ -5,9 +5,18 @@
 //  http://www.boost.org/LICENSE_1_0.txt)
 
 #include <doctest/doctest.h>
+#include <cstdio>
 #include <fplus/fplus.hpp>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
 TEST_CASE("side_effects_test - execute")
 {
     using namespace fplus;
@@ -77,6 +86,22 @@ TEST_CASE("side_effects_test - execute_parallelly_atomic")
     REQUIRE_EQ(atomic_int.load(), 4);
 }
 
+TEST_CASE("side_effects_test - execute_parallelly_n_threads_cancellable")
+{
+    using namespace fplus;
+    typedef result<std::vector<int>, std::string> Result;
+    auto return_one = [&]() { return 1; };
+    const cancellation_token token;
+    const auto effect = execute_parallelly_n_threads_cancellable(token, 2, replicate(4, return_one));
+    REQUIRE_EQ(effect(), Result(ok<std::vector<int>, std::string>({ 1, 1, 1, 1 })));
+    REQUIRE_EQ(execute_parallelly_cancellable(token, replicate(3, return_one))(),
+        Result(ok<std::vector<int>, std::string>({ 1, 1, 1 })));
+    token.cancel();
+    REQUIRE_EQ(effect(), Result(error<std::vector<int>, std::string>("cancelled")));
+    REQUIRE_EQ(execute_parallelly_cancellable(token, replicate(3, return_one))(),
+        Result(error<std::vector<int>, std::string>("cancelled")));
+}
+
 TEST_CASE("side_effects_test - for_each (serial and parallel")
 {
     using namespace fplus;
@@ -96,3 +121,238 @@ TEST_CASE("side_effects_test - for_each (serial and parallel")
         REQUIRE_EQ(nb_filled, nb_elems);
     }
 }
+
+TEST_CASE("side_effects_test - read_text_file_lines_streaming")
+{
+    using namespace fplus;
+    typedef std::vector<std::string> Strings;
+    const std::string filename = "side_effects_test_lines.txt";
+    const Strings contents = {
+        "", "a", "\n", "a\n", "a\r\nbb\r\n\r\nccc", "a\rb\r\rc\r", "\r\n\n\r",
+        std::string(100000, 'x') + "\r\n" + std::string(70000, 'y') + "\n\nz"
+    };
+    for (const auto& content : contents) {
+        REQUIRE(write_text_file(filename, content)());
+        for (const bool allow_empty : { false, true }) {
+            const auto expected = split_lines(allow_empty, content);
+            REQUIRE_EQ(read_text_file_lines(allow_empty, filename)(), expected);
+            Strings lines;
+            REQUIRE(for_each_line([&](const std::string& line) {
+                lines.push_back(line);
+            },
+                allow_empty, filename)());
+            REQUIRE_EQ(lines, expected);
+            REQUIRE_EQ(fold_lines([](std::size_t acc, const std::string& line) {
+                return acc + line.size();
+            },
+                           std::size_t(0), allow_empty, filename)(),
+                just(sum(transform(size_of_cont<std::string>, expected))));
+            Strings lazy_lines;
+            for (const auto& line : text_file_lines(allow_empty, filename)) {
+                lazy_lines.push_back(line);
+            }
+            REQUIRE_EQ(lazy_lines, expected);
+            // Every "\r\n" is split by the buffer boundary at some size.
+            for (std::size_t buffer_size = 1; buffer_size < 5; ++buffer_size) {
+                line_reader reader(filename, buffer_size);
+                Strings small_buffer_lines;
+                std::string line;
+                while (reader.next(line)) {
+                    if (allow_empty || !line.empty())
+                        small_buffer_lines.push_back(line);
+                }
+                REQUIRE_EQ(small_buffer_lines, expected);
+            }
+        }
+    }
+    std::remove(filename.c_str());
+
+    REQUIRE_FALSE(for_each_line([](const std::string&) {}, true, "does_not_exist.txt")());
+    REQUIRE_EQ(fold_lines([](int acc, const std::string&) { return acc + 1; },
+                   0, true, "does_not_exist.txt")(),
+        nothing<int>());
+    REQUIRE_EQ(read_text_file_lines_maybe(true, "does_not_exist.txt")(), nothing<Strings>());
+    const auto missing = text_file_lines(true, "does_not_exist.txt");
+    REQUIRE_FALSE(missing.is_open());
+}
+
+TEST_CASE("side_effects_test - file_writers")
+{
+    using namespace fplus;
+    typedef std::vector<std::string> Strings;
+    const std::string filename = "side_effects_test_writers.txt";
+
+    REQUIRE(write_text_file_lines(true, filename, Strings({ "a", "", "b" }))());
+    REQUIRE_EQ(read_text_file(filename)(), "a\n\nb\n");
+    REQUIRE(write_text_file_lines(false, filename, Strings({ "a", "b" }))());
+    REQUIRE_EQ(read_text_file(filename)(), "a\nb");
+
+    const std::string content = "first\nsecond\nthird";
+    REQUIRE(write_text_file_chunks(filename, split_lines_views(true, content))());
+    REQUIRE_EQ(read_text_file(filename)(), "firstsecondthird");
+    REQUIRE(write_text_file_chunks(filename, Strings({ "x", "", "yz" }))());
+    REQUIRE_EQ(read_text_file(filename)(), "xyz");
+
+    std::size_t n = 0;
+    REQUIRE(write_text_file_generated(filename, [&n]() -> maybe<std::string> {
+        if (n == 3)
+            return nothing<std::string>();
+        return just(std::to_string(n++) + "\n");
+    })());
+    REQUIRE_EQ(read_text_file(filename)(), "0\n1\n2\n");
+
+    const std::vector<std::uint8_t> bytes = { 0, 1, 2, 255 };
+    REQUIRE(write_binary_file(filename, make_span_view(bytes))());
+    REQUIRE_EQ(read_binary_file(filename)(), bytes);
+
+    {
+        // An atomic writer replaces the file only when closed.
+        file_writer writer(filename, true, true);
+        REQUIRE(writer.good());
+        writer.write(std::string("new "));
+        writer.put('c');
+        REQUIRE_EQ(read_binary_file(filename)(), bytes);
+        REQUIRE(writer.close());
+        REQUIRE_EQ(read_text_file(filename)(), "new c");
+        // A closed writer can not be written to, closing again is a no-op.
+        REQUIRE_FALSE(writer.good());
+        REQUIRE_FALSE(writer.write(std::string("more")));
+        REQUIRE_FALSE(writer.put('x'));
+        REQUIRE(writer.close());
+        REQUIRE_EQ(read_text_file(filename)(), "new c");
+    }
+    {
+        file_writer writer(filename, true);
+        writer.write(std::string("discarded"));
+    }
+    REQUIRE_EQ(read_text_file(filename)(), "new c");
+    REQUIRE(write_text_file_atomic(false, filename, "atomic")());
+    REQUIRE_EQ(read_text_file(filename)(), "atomic");
+    std::remove(filename.c_str());
+
+    file_writer broken("does_not_exist/file.txt");
+    REQUIRE_FALSE(broken.good());
+    REQUIRE_FALSE(broken.write(std::string("x")));
+    REQUIRE_FALSE(broken.close());
+    REQUIRE_FALSE(broken.close());
+    REQUIRE_FALSE(write_text_file_atomic(false, "does_not_exist/file.txt", "x")());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("side_effects_test - write_text_file_atomic_keeps_permissions")
+{
+    using namespace fplus;
+    const std::string filename = "side_effects_test_permissions.txt";
+    REQUIRE(write_text_file(filename, "old")());
+    REQUIRE_EQ(::chmod(filename.c_str(), 0600), 0);
+    REQUIRE(write_text_file_atomic(false, filename, "new")());
+    REQUIRE_EQ(read_text_file(filename)(), "new");
+    struct stat result;
+    REQUIRE_EQ(::stat(filename.c_str(), &result), 0);
+    REQUIRE_EQ(result.st_mode & 07777, 0600u);
+    std::remove(filename.c_str());
+}
+#endif
+
+namespace {
+template <typename Effect>
+std::string run_interactively(std::streambuf& input, Effect eff)
+{
+    std::ostringstream out;
+    std::streambuf* const cin_buf = std::cin.rdbuf(&input);
+    std::streambuf* const cout_buf = std::cout.rdbuf(out.rdbuf());
+    const auto restore = [&]() {
+        std::cin.rdbuf(cin_buf);
+        std::cout.rdbuf(cout_buf);
+        std::cin.clear();
+    };
+    try {
+        eff();
+    } catch (...) {
+        restore();
+        throw;
+    }
+    restore();
+    return out.str();
+}
+
+template <typename Effect>
+std::string run_interactively(const std::string& input, Effect eff)
+{
+    std::istringstream in(input);
+    return run_interactively(*in.rdbuf(), eff);
+}
+
+// Like the buffer of std::cin synchronized with C stdio,
+// it does not know how many characters are available.
+class unbuffered_streambuf : public std::streambuf {
+public:
+    explicit unbuffered_streambuf(const std::string& str)
+        : std::streambuf()
+        , str_(str)
+        , pos_(0)
+    {
+    }
+
+protected:
+    int_type underflow() override
+    {
+        return pos_ < str_.size() ? traits_type::to_int_type(str_[pos_]) : traits_type::eof();
+    }
+    int_type uflow() override
+    {
+        const int_type c = underflow();
+        if (c != traits_type::eof()) {
+            ++pos_;
+        }
+        return c;
+    }
+
+private:
+    std::string str_;
+    std::size_t pos_;
+};
+}
+
+TEST_CASE("side_effects_test - interact_by_line_and_chunk")
+{
+    using namespace fplus;
+    const auto shout = [](const std::string& str) { return to_upper_case(str); };
+    REQUIRE_EQ(run_interactively("ab\ncd\r\n\nef", interact_by_line(shout)),
+        "AB\nCD\n\nEF\n");
+    REQUIRE_EQ(run_interactively("ab\n", interact_by_line(shout)), "AB\n");
+    REQUIRE_EQ(run_interactively("", interact_by_line(shout)), "");
+    std::size_t line_count = 0;
+    run_interactively("1\n2\n3\n", interact_by_line([&](const std::string& line) {
+        ++line_count;
+        return line;
+    }));
+    REQUIRE_EQ(line_count, 3);
+
+    const std::string long_input = std::string(100000, 'x') + "\nyz\r\n";
+    REQUIRE_EQ(run_interactively(long_input, interact_by_chunk(shout)),
+        to_upper_case(long_input));
+    REQUIRE_EQ(run_interactively("", interact_by_chunk(shout)), "");
+
+    std::size_t chunk_count = 0;
+    const auto count_chunks = [&](const std::string& chunk) {
+        ++chunk_count;
+        return chunk;
+    };
+    unbuffered_streambuf unbuffered("ab\ncd\n" + long_input);
+    REQUIRE_EQ(run_interactively(unbuffered, interact_by_chunk(count_chunks)),
+        "ab\ncd\n" + long_input);
+    REQUIRE_EQ(chunk_count, 5);
+
+    std::ostream* const tied = std::cin.tie();
+    bool caught = false;
+    try {
+        run_interactively("x", interact_by_chunk([](const std::string&) -> std::string {
+            throw std::runtime_error("fail");
+        }));
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+    REQUIRE_EQ(std::cin.tie(), tied);
+}
@@ -0,0 +1,179 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+typedef fplus::small_vector<int, 4> SmallInts;
+typedef fplus::small_vector<std::string, 2> SmallStrings;
+
+// Has no move constructor, so growing a small_vector copies it.
+// Keeps track of the addresses of all living instances.
+struct ThrowingCopy {
+    explicit ThrowingCopy(int x)
+        : x_(x)
+    {
+        alive().insert(this);
+    }
+    ThrowingCopy(const ThrowingCopy& other)
+        : x_(other.x_)
+    {
+        if (copies_left == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        --copies_left;
+        alive().insert(this);
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ~ThrowingCopy()
+    {
+        if (alive().erase(this) == 0) {
+            ++double_destructions;
+        }
+    }
+    static std::set<const ThrowingCopy*>& alive()
+    {
+        static std::set<const ThrowingCopy*> instances;
+        return instances;
+    }
+    int x_;
+    static int copies_left;
+    static int double_destructions;
+};
+int ThrowingCopy::copies_left = 1000;
+int ThrowingCopy::double_destructions = 0;
+}
+
+TEST_CASE("small_vector_test - inline_and_heap_storage")
+{
+    using namespace fplus;
+    SmallInts xs;
+    REQUIRE(xs.empty());
+    REQUIRE(xs.is_inline());
+    REQUIRE_EQ(xs.capacity(), 4);
+    for (int i = 0; i < 4; ++i)
+        xs.push_back(i);
+    REQUIRE(xs.is_inline());
+    xs.push_back(4);
+    REQUIRE_FALSE(xs.is_inline());
+    REQUIRE_EQ(xs, SmallInts({ 0, 1, 2, 3, 4 }));
+    xs.push_back(xs.front());
+    REQUIRE_EQ(xs.back(), 0);
+
+    SmallInts moved = std::move(xs);
+    REQUIRE_EQ(moved.size(), 6);
+    REQUIRE(xs.empty());
+    REQUIRE(xs.is_inline());
+
+    SmallInts small = { 1, 2 };
+    SmallInts small_moved = std::move(small);
+    REQUIRE(small_moved.is_inline());
+    REQUIRE_EQ(small_moved, SmallInts({ 1, 2 }));
+
+    SmallInts copied = moved;
+    REQUIRE_EQ(copied, moved);
+    copied = small_moved;
+    REQUIRE_EQ(copied, SmallInts({ 1, 2 }));
+    swap(copied, moved);
+    REQUIRE_EQ(moved, SmallInts({ 1, 2 }));
+    REQUIRE_EQ(copied.size(), 6);
+    REQUIRE_EQ(moved.at(1), 2);
+}
+
+TEST_CASE("small_vector_test - modifiers")
+{
+    using namespace fplus;
+    SmallStrings xs = { "b", "d" };
+    xs.insert(xs.begin(), "a");
+    xs.insert(xs.begin() + 2, std::string("c"));
+    xs.insert(xs.end(), 2, "e");
+    REQUIRE_EQ(xs, SmallStrings({ "a", "b", "c", "d", "e", "e" }));
+    const std::vector<std::string> fs = { "f", "g" };
+    xs.insert(xs.end(), fs.begin(), fs.end());
+    xs.erase(xs.begin() + 4);
+    REQUIRE_EQ(xs, SmallStrings({ "a", "b", "c", "d", "e", "f", "g" }));
+    xs.erase(xs.begin(), xs.begin() + 5);
+    REQUIRE_EQ(xs, SmallStrings({ "f", "g" }));
+    xs.emplace(xs.begin() + 1, std::size_t(3), 'x');
+    REQUIRE_EQ(xs, SmallStrings({ "f", "xxx", "g" }));
+    xs.resize(1);
+    REQUIRE_EQ(xs, SmallStrings({ "f" }));
+    xs.resize(3, "z");
+    REQUIRE_EQ(xs, SmallStrings({ "f", "z", "z" }));
+    xs.pop_back();
+    xs.assign(2, "y");
+    REQUIRE_EQ(xs, SmallStrings({ "y", "y" }));
+    REQUIRE(SmallStrings({ "a" }) < SmallStrings({ "b" }));
+    xs.clear();
+    REQUIRE(xs.empty());
+
+    fplus::small_vector<std::unique_ptr<int>, 1> ptrs;
+    ptrs.push_back(std::make_unique<int>(1));
+    ptrs.push_back(std::make_unique<int>(2));
+    REQUIRE_EQ(*ptrs[1], 2);
+}
+
+TEST_CASE("small_vector_test - as_fplus_container")
+{
+    using namespace fplus;
+    const SmallInts xs = { 3, 1, 2 };
+    const auto squares = transform([](int x) { return x * x; }, xs);
+    REQUIRE_EQ(squares, SmallInts({ 9, 1, 4 }));
+    const auto strs = transform([](int x) { return std::to_string(x); }, xs);
+    REQUIRE_EQ(strs, small_vector<std::string, 4>({ "3", "1", "2" }));
+    REQUIRE_EQ(keep_if(is_odd<int>, xs), SmallInts({ 3, 1 }));
+    REQUIRE_EQ(sort(xs), SmallInts({ 1, 2, 3 }));
+    REQUIRE_EQ(reverse(xs), SmallInts({ 2, 1, 3 }));
+    REQUIRE_EQ(split_at_idx(1, xs), std::make_pair(SmallInts({ 3 }), SmallInts({ 1, 2 })));
+    REQUIRE_EQ(partition(is_odd<int>, xs), std::make_pair(SmallInts({ 3, 1 }), SmallInts({ 2 })));
+    REQUIRE_EQ(append(xs, xs), SmallInts({ 3, 1, 2, 3, 1, 2 }));
+    REQUIRE_EQ(sum(xs), 6);
+    REQUIRE_EQ(show_cont(xs), "[3, 1, 2]");
+
+    const std::vector<int> ys = { 1, 2, 3, 4, 5 };
+    REQUIRE_EQ(convert_container<SmallInts>(ys), SmallInts({ 1, 2, 3, 4, 5 }));
+    REQUIRE_EQ(transform_convert<SmallInts>([](int y) { return 2 * y; }, take(2, ys)),
+        SmallInts({ 2, 4 }));
+}
+
+TEST_CASE("small_vector_test - exception_safe_growth")
+{
+    using namespace fplus;
+    {
+        small_vector<ThrowingCopy, 2> xs;
+        xs.emplace_back(1);
+        xs.emplace_back(2);
+        // The new element and the first old one can be copied,
+        // the second old one can not.
+        ThrowingCopy::copies_left = 2;
+        bool thrown = false;
+        try {
+            xs.push_back(ThrowingCopy(3));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        REQUIRE(thrown);
+        REQUIRE(xs.is_inline());
+        REQUIRE_EQ(xs.size(), 2);
+        REQUIRE_EQ(xs[0].x_, 1);
+        REQUIRE_EQ(xs[1].x_, 2);
+        REQUIRE_EQ(ThrowingCopy::alive().size(), 2);
+        REQUIRE_EQ(ThrowingCopy::alive().count(&xs[0]), 1);
+        REQUIRE_EQ(ThrowingCopy::alive().count(&xs[1]), 1);
+        ThrowingCopy::copies_left = 1000;
+        xs.push_back(ThrowingCopy(3));
+        REQUIRE_EQ(xs.size(), 3);
+        REQUIRE_EQ(xs[2].x_, 3);
+    }
+    REQUIRE(ThrowingCopy::alive().empty());
+    REQUIRE_EQ(ThrowingCopy::double_destructions, 0);
+}
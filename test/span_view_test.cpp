@@ -0,0 +1,150 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+typedef std::vector<int> IntVector;
+typedef std::vector<IntVector> IntVectors;
+typedef std::vector<std::string> StringVector;
+auto is_even_int = [](int x) { return x % 2 == 0; };
+
+template <typename Views>
+IntVectors views_to_vectors(const Views& views)
+{
+    return fplus::transform([](const typename Views::value_type& view) {
+        return IntVector(std::begin(view), std::end(view));
+    },
+        views);
+}
+
+template <typename Views>
+StringVector views_to_strings(const Views& views)
+{
+    return fplus::transform([](const typename Views::value_type& view) {
+        return std::string(std::begin(view), std::end(view));
+    },
+        views);
+}
+}
+
+TEST_CASE("span_view_test - span_view")
+{
+    using namespace fplus;
+    IntVector xs = { 1, 2, 3, 4 };
+    const auto view = make_span_view(xs);
+    REQUIRE_EQ(view.size(), 4);
+    REQUIRE_EQ(view.data(), xs.data());
+    REQUIRE_EQ(view[2], 3);
+    REQUIRE_EQ(view.front(), 1);
+    REQUIRE_EQ(view.back(), 4);
+    view[0] = 5;
+    REQUIRE_EQ(xs[0], 5);
+
+    const span_view<const int> const_view = view;
+    REQUIRE(const_view == view);
+    REQUIRE(const_view != take_view(2, xs));
+    REQUIRE(span_view<int>().empty());
+
+    const std::array<int, 3> arr = { { 1, 2, 3 } };
+    REQUIRE_EQ(make_span_view(arr).size(), 3);
+}
+
+TEST_CASE("span_view_test - algorithms_on_views")
+{
+    using namespace fplus;
+    const IntVector xs = { 1, 2, 3, 4, 5, 6 };
+    const auto view = get_segment_view(1, 4, xs);
+    REQUIRE_EQ(sum(view), 9);
+    REQUIRE_EQ(fold_left(std::plus<int>(), 0, view), 9);
+    REQUIRE_EQ(transform(square<int>, view), IntVector({ 4, 9, 16 }));
+    REQUIRE_EQ(transform(square<int>, take_view(2, xs)), IntVector({ 1, 4 }));
+    REQUIRE_EQ(maximum(view), 4);
+    REQUIRE_EQ(count_if(is_even_int, view), 2);
+    REQUIRE(is_elem_of(3, view));
+    REQUIRE_EQ(find_first_by(is_even_int, view), just(2));
+    REQUIRE_EQ(convert_container<IntVector>(view), IntVector({ 2, 3, 4 }));
+    REQUIRE_EQ(show_cont(view), std::string("[2, 3, 4]"));
+}
+
+TEST_CASE("span_view_test - get_segment_view")
+{
+    using namespace fplus;
+    const IntVector xs = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    for (std::size_t idx_begin = 0; idx_begin < 12; ++idx_begin) {
+        for (std::size_t idx_end = 0; idx_end < 12; ++idx_end) {
+            const auto view = get_segment_view(idx_begin, idx_end, xs);
+            REQUIRE_EQ(IntVector(std::begin(view), std::end(view)),
+                get_segment(idx_begin, idx_end, xs));
+        }
+    }
+    for (std::size_t n = 0; n < 12; ++n) {
+        const auto taken = take_view(n, xs);
+        const auto dropped = drop_view(n, xs);
+        REQUIRE_EQ(IntVector(std::begin(taken), std::end(taken)), take(n, xs));
+        REQUIRE_EQ(IntVector(std::begin(dropped), std::end(dropped)), drop(n, xs));
+    }
+    const auto view = get_segment_view(2, 7, xs);
+    const auto sub_view = get_segment_view(1, 3, view);
+    REQUIRE_EQ(IntVector(std::begin(sub_view), std::end(sub_view)), IntVector({ 3, 4 }));
+}
+
+TEST_CASE("span_view_test - split_views")
+{
+    using namespace fplus;
+    const IntVector xs = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    for (std::size_t n = 1; n < 10; ++n) {
+        REQUIRE_EQ(views_to_vectors(split_every_views(n, xs)), split_every(n, xs));
+        if (n <= xs.size()) {
+            REQUIRE_EQ(views_to_vectors(aperture_views(n, xs)), aperture(n, xs));
+        }
+    }
+    REQUIRE(aperture_views(9, xs).empty());
+
+    for (const IntVector& ys : IntVectors({ {}, { 1 }, { 2 }, { 2, 2 },
+             { 1, 3, 2, 2, 5, 5, 3, 6, 7, 9 }, { 2, 1, 2 } })) {
+        for (const bool allow_empty : { false, true }) {
+            REQUIRE_EQ(views_to_vectors(split_by_views(is_even_int, allow_empty, ys)),
+                split_by(is_even_int, allow_empty, ys));
+        }
+    }
+}
+
+TEST_CASE("span_view_test - split_lines_views")
+{
+    using namespace fplus;
+    REQUIRE_EQ(views_to_strings(split_lines_views(false, std::string("Hi,\r\nhow are you?"))),
+        StringVector({ "Hi,", "how are you?" }));
+    for (const std::string str : { "", "a", "\n", "\r\n", "\r\r\n\n", "a\nb",
+             "a\r\nb\rc\n\rd", "\ra\r", "a\n\n", "\r\n\r\na" }) {
+        for (const bool allow_empty : { false, true }) {
+            REQUIRE_EQ(views_to_strings(split_lines_views(allow_empty, str)),
+                split_lines(allow_empty, str));
+        }
+    }
+
+    // Line breaks far away and around the boundaries of the search windows.
+    for (const std::size_t line_length : { 1000u, 1023u, 1024u, 1025u, 3000u }) {
+        for (const std::string line_break : { "\n", "\r", "\r\n" }) {
+            std::string str;
+            for (std::size_t i = 0; i < 3; ++i) {
+                str += std::string(line_length, 'x') + line_break;
+            }
+            str += std::string(line_length, 'y');
+            REQUIRE_EQ(views_to_strings(split_lines_views(false, str)),
+                split_lines(false, str));
+        }
+    }
+    std::string cr_only;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        cr_only += "ab\r";
+    }
+    REQUIRE_EQ(split_lines_views(false, cr_only).size(), 100000);
+}
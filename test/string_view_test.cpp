@@ -0,0 +1,111 @@
+// Copyright 2015, Tobias Hermann and the FunctionalPlus contributors.
+// https://github.com/Dobiasd/FunctionalPlus
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <fplus/fplus.hpp>
+#include <string>
+#include <vector>
+
+#if defined(__cpp_lib_string_view)
+
+#include <string_view>
+#include <type_traits>
+
+namespace {
+typedef std::vector<std::string> StringVector;
+typedef std::vector<std::string_view> StringViewVector;
+
+StringVector to_strings(const StringViewVector& views)
+{
+    return fplus::transform([](std::string_view view) {
+        return std::string(view);
+    },
+        views);
+}
+}
+
+TEST_CASE("string_view_test - views_of_strings_are_string_views")
+{
+    using namespace fplus;
+    const std::string str = "How are you?";
+    static_assert(std::is_same<decltype(split_lines_views(true, str)),
+                      StringViewVector>::value,
+        "strings are viewed as std::string_view");
+    static_assert(std::is_same<decltype(get_segment_view(0, 3, str)),
+                      std::string_view>::value,
+        "strings are viewed as std::string_view");
+    REQUIRE_EQ(get_segment_view(4, 7, str), "are");
+    REQUIRE_EQ(take_view(3, std::string_view(str)), "How");
+    REQUIRE_EQ(drop_view(8, str), "you?");
+}
+
+TEST_CASE("string_view_test - split_views")
+{
+    using namespace fplus;
+    const std::string str = "How are  you?";
+    REQUIRE_EQ(split_words_views(false, str), StringViewVector({ "How", "are", "you" }));
+    REQUIRE_EQ(split_views(' ', true, str), StringViewVector({ "How", "are", "", "you?" }));
+    REQUIRE_EQ(split_one_of_views(std::string(" o"), false, str),
+        StringViewVector({ "H", "w", "are", "y", "u?" }));
+    REQUIRE_EQ(split_by_views(is_equal_to(' '), false, std::string_view(str)),
+        StringViewVector({ "How", "are", "you?" }));
+
+    for (const std::string s : { "", "a b", " a  b ", "ab?!cd" }) {
+        for (const bool allow_empty : { false, true }) {
+            REQUIRE_EQ(to_strings(split_words_views(allow_empty, s)),
+                split_words(allow_empty, s));
+            REQUIRE_EQ(to_strings(split_views(' ', allow_empty, s)),
+                split(' ', allow_empty, s));
+            REQUIRE_EQ(to_strings(split_one_of_views(std::string("b "), allow_empty, s)),
+                split_one_of(std::string("b "), allow_empty, s));
+        }
+    }
+}
+
+TEST_CASE("string_view_test - split_lines_views")
+{
+    using namespace fplus;
+    const std::string str = "one\r\ntwo\rthree\n\nfour";
+    REQUIRE_EQ(split_lines_views(false, str),
+        StringViewVector({ "one", "two", "three", "four" }));
+    REQUIRE_EQ(split_lines_views(true, std::string_view(str)),
+        StringViewVector({ "one", "two", "three", "", "four" }));
+
+    std::size_t line_count = 0;
+    std::size_t char_count = 0;
+    for_each_line_view([&](std::string_view line) {
+        ++line_count;
+        char_count += line.size();
+    },
+        true, str);
+    REQUIRE_EQ(line_count, 5);
+    REQUIRE_EQ(char_count, 15);
+
+    std::vector<std::size_t> sizes;
+    for_each_split_by_view([&](std::string_view piece) {
+        sizes.push_back(piece.size());
+    },
+        is_equal_to('\n'), false, str);
+    REQUIRE_EQ(sizes, std::vector<std::size_t>({ 4, 9, 4 }));
+}
+
+TEST_CASE("string_view_test - read_value_view")
+{
+    using namespace fplus;
+    REQUIRE_EQ(read_value_view<int>(std::string_view("42")), just<int>(42));
+    REQUIRE_EQ(read_value_view<double>(std::string_view("-0.5")), just<double>(-0.5));
+    REQUIRE_EQ(read_values<int>(split_views(',', true, std::string_view("1,2,3"))),
+        just(std::vector<int>({ 1, 2, 3 })));
+#if defined(__cpp_lib_to_chars)
+    REQUIRE_EQ(read_value_view<int>(std::string_view(" 42")), nothing<int>());
+    REQUIRE_EQ(read_value_view<int>(std::string_view("+42")), nothing<int>());
+    REQUIRE_EQ(read_value_view<unsigned int>(std::string_view("-1")), nothing<unsigned int>());
+    REQUIRE_EQ(read_value_view_result<int>(std::string_view("99999999999999999999")),
+        (error<int, std::string>("Value out of range.")));
+#endif
+}
+
+#endif
@@ -4,8 +4,11 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 //  http://www.boost.org/LICENSE_1_0.txt)
 
+#include <clocale>
+#include <cstdint>
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <string>
 #include <vector>
 
 TEST_CASE("stringtools_test -  trim")
@@ -83,3 +86,72 @@ TEST_CASE("stringtools_test -  to_upper_case")
     using namespace fplus;
     REQUIRE_EQ(to_upper_case(std::string("ChaRacTer&WorDs34")), std::string("CHARACTER&WORDS34"));
 }
+
+TEST_CASE("stringtools_test -  ascii_fast_paths")
+{
+    using namespace fplus;
+    typedef std::vector<char> Chars;
+    const std::string alphabet = "aZz@[` \t\n\r\v\f\x0e\x08\xc3\xa4\x80\xff.";
+    std::uint32_t state = 42;
+    const auto random_char = [&]() {
+        state = state * 1664525u + 1013904223u;
+        return alphabet[(state >> 16) % alphabet.size()];
+    };
+    for (std::size_t size = 0; size < 150; ++size) {
+        for (std::size_t padding = 0; padding < 40; padding += 13) {
+            std::string str(padding, ' ');
+            for (std::size_t i = 0; i < size; ++i) {
+                str.push_back(random_char());
+            }
+            str += std::string(padding, '\n');
+            const Chars chars(std::begin(str), std::end(str));
+            const auto to_string = [](const Chars& xs) {
+                return std::string(std::begin(xs), std::end(xs));
+            };
+            REQUIRE_EQ(to_lower_case(str), to_string(to_lower_case(chars)));
+            REQUIRE_EQ(to_upper_case(str), to_string(to_upper_case(chars)));
+            REQUIRE_EQ(trim_whitespace_left(str), to_string(trim_whitespace_left(chars)));
+            REQUIRE_EQ(trim_whitespace_right(str), to_string(trim_whitespace_right(chars)));
+            REQUIRE_EQ(trim_whitespace(str), to_string(trim_whitespace(chars)));
+            REQUIRE_EQ(clean_newlines(str), replace_elems('\r', '\n',
+                                                 replace_tokens(std::string("\r\n"), std::string("\n"), str)));
+            REQUIRE_EQ(count_line_breaks(str), count_line_breaks(chars));
+            REQUIRE_EQ(count_line_breaks(str), count(std::string::value_type('\n'), clean_newlines(str)));
+        }
+    }
+}
+
+TEST_CASE("stringtools_test -  change_case_in_other_c_locales")
+{
+    using namespace fplus;
+    const std::string previous = std::setlocale(LC_CTYPE, nullptr);
+    for (const char* name : { "C.UTF-8", "C.utf8", "en_US.UTF-8", "tr_TR.UTF-8" }) {
+        if (std::setlocale(LC_CTYPE, name) == nullptr) {
+            continue;
+        }
+        const std::string str = "Istanbul IIIII iiiii ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz";
+        const std::vector<char> chars(std::begin(str), std::end(str));
+        const auto lower = to_lower_case(str);
+        const auto upper = to_upper_case(str);
+        REQUIRE_EQ(std::vector<char>(std::begin(lower), std::end(lower)), to_lower_case(chars));
+        REQUIRE_EQ(std::vector<char>(std::begin(upper), std::end(upper)), to_upper_case(chars));
+    }
+    std::setlocale(LC_CTYPE, previous.c_str());
+}
+
+TEST_CASE("stringtools_test -  count_line_breaks")
+{
+    using namespace fplus;
+    REQUIRE_EQ(count_line_breaks(std::string()), 0);
+    REQUIRE_EQ(count_line_breaks(std::string("a\nb\r\nc\rd")), 3);
+    REQUIRE_EQ(count_line_breaks(std::string("\r\r\n\n\r")), 4);
+}
+
+TEST_CASE("stringtools_test -  to_string_fill")
+{
+    using namespace fplus;
+    REQUIRE_EQ(to_string_fill_left('0', 5, 42), std::string("00042"));
+    REQUIRE_EQ(to_string_fill_left(' ', 1, -42), std::string("-42"));
+    REQUIRE_EQ(to_string_fill_right(' ', 5, 42), std::string("42   "));
+    REQUIRE_EQ(to_string_fill_right(' ', 0, 42), std::string("42"));
+}
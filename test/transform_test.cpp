@@ -6,6 +6,7 @@
 
 #include <doctest/doctest.h>
 #include <fplus/fplus.hpp>
+#include <atomic>
 
 namespace {
 typedef std::vector<int> IntVector;
@@ -52,6 +53,28 @@ TEST_CASE("transform_test - transpose")
     REQUIRE_EQ(transpose(IntVectors({ { 1, 2, 3 }, { 4, 5, 6 } })), IntVectors({ { 1, 4 }, { 2, 5 }, { 3, 6 } }));
     REQUIRE_EQ(transpose(IntVectors({ { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } })), IntVectors({ { 1, 4, 7 }, { 2, 5, 8 }, { 3, 6, 9 } }));
     REQUIRE_EQ(transpose(IntVectors({ { 1, 2, 3 }, { 4, 5 }, { 7, 8, 9 } })), IntVectors({ { 1, 4, 7 }, { 2, 5, 8 }, { 3, 9 } }));
+    REQUIRE_EQ(transpose(IntVectors({ {}, {} })), internal::transpose_interleaved(IntVectors({ {}, {} })));
+    REQUIRE_EQ(transpose(std::list<IntVector>({ { 1, 2 }, { 3, 4 } })), std::list<IntVector>({ { 1, 3 }, { 2, 4 } }));
+}
+
+TEST_CASE("transform_test - transpose_blocked")
+{
+    using namespace fplus;
+    // Larger than one tile, and not a multiple of the tile size.
+    for (const auto& shape : std::vector<std::pair<std::size_t, std::size_t>>({ { 70, 45 }, { 33, 100 }, { 1, 65 } })) {
+        IntVectors rows(shape.first, IntVector(shape.second));
+        for (std::size_t row = 0; row < shape.first; ++row) {
+            for (std::size_t col = 0; col < shape.second; ++col) {
+                rows[row][col] = static_cast<int>(row * 1000 + col);
+            }
+        }
+        const auto transposed = transpose(rows);
+        REQUIRE_EQ(transposed, internal::transpose_interleaved(rows));
+        REQUIRE_EQ(transpose(transposed), rows);
+    }
+    typedef std::vector<std::string> Strings;
+    REQUIRE_EQ(transpose(std::vector<Strings>({ { "a", "b" }, { "c", "d" } })),
+        std::vector<Strings>({ { "a", "c" }, { "b", "d" } }));
 }
 
 TEST_CASE("transform_test - shuffle")
@@ -129,6 +152,11 @@ TEST_CASE("transform_test - transform")
     REQUIRE_EQ(transform_convert_parallelly<IntList>(squareLambda, xs), IntList({ 1, 4, 4, 9, 4 }));
 
     REQUIRE_EQ(transform(squareLambda, std::set<int>({ 1, 2, 3, -3 })), std::set<int>({ 1, 4, 9 }));
+    typedef std::set<int, std::greater<int>> IntSetDesc;
+    REQUIRE_EQ(transform([](int x) { return x * 10; }, IntSetDesc({ 1, 2, 3 })), IntSetDesc({ 30, 20, 10 }));
+    REQUIRE_EQ(*transform([](int x) { return x * 10; }, IntSetDesc({ 1, 2, 3 })).begin(), 30);
+    REQUIRE_EQ(*transform([](int x) { return std::to_string(x); }, IntSetDesc({ 1, 2, 3 })).begin(), "3");
+    REQUIRE_EQ(*transform([](int x) { return -x; }, std::set<int, std::less<>>({ 1, 2 })).begin(), -2);
     REQUIRE_EQ(transform_inner(intTimes2, IntVectors({ { 1, 3, 4 }, { 1, 2 } })), IntVectors({ { 2, 6, 8 }, { 2, 4 } }));
 
     typedef std::array<int, 2> IntArray2;
@@ -161,6 +189,28 @@ TEST_CASE("transform_test - reduce")
     REQUIRE_EQ(reduce_1_parallelly(std::plus<int>(), xs), 10);
 }
 
+TEST_CASE("transform_test - mean_stddev_parallelly")
+{
+    using namespace fplus;
+    typedef std::vector<double> DoubleVector;
+    DoubleVector ys;
+    for (std::size_t i = 0; i < 300007; ++i) {
+        ys.push_back(static_cast<double>((i * 7919) % 1000) / 10.0 - 20.0);
+    }
+    const auto expected = mean_stddev<double>(ys);
+    const auto check = [&expected](const std::pair<double, double>& ms) {
+        REQUIRE_EQ(ms.first, doctest::Approx(expected.first));
+        REQUIRE_EQ(ms.second, doctest::Approx(expected.second));
+    };
+    check(mean_stddev_parallelly<double>(ys));
+    for (std::size_t n : std::vector<std::size_t>({ 1, 2, 3, 7 })) {
+        check(mean_stddev_parallelly_n_threads<double>(n, ys));
+        check(mean_stddev_parallelly_n_threads<double>(n, std::list<double>(ys.begin(), ys.end())));
+    }
+    REQUIRE_EQ(mean_stddev_parallelly_n_threads<double>(4, IntVector({ 4, 8 })), std::make_pair(6.0, 2.0));
+    REQUIRE_EQ(mean_stddev_parallelly<double>(IntVector({ 4, 8 })), std::make_pair(6.0, 2.0));
+}
+
 TEST_CASE("transform_test - keep_if_parallelly")
 {
     const std::vector<int> v = { 1, 2, 3, 2, 4, 5 };
@@ -168,6 +218,103 @@ TEST_CASE("transform_test - keep_if_parallelly")
     REQUIRE_EQ(result, std::vector<int>({ 2, 2, 4 }));
 }
 
+TEST_CASE("transform_test - transform_parallelly_n_threads_cancellable")
+{
+    using namespace fplus;
+    typedef result<IntVector, std::string> Result;
+    const cancellation_token token;
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(token, 3, squareLambda, xs), Result(ok<IntVector, std::string>({ 1, 4, 4, 9, 4 })));
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(token, 3, squareLambda, IntVector()), Result(ok<IntVector, std::string>({})));
+
+    const auto cancel_on_3 = [&token](int x) {
+        if (x == 3) {
+            token.cancel();
+        }
+        return x;
+    };
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(token, 1, cancel_on_3, xs), Result(error<IntVector, std::string>("cancelled")));
+    REQUIRE(token.is_cancelled());
+    REQUIRE_FALSE(token.deadline_exceeded());
+
+    const cancellation_token expired(cancellation_token::clock::now());
+    REQUIRE(expired.is_cancelled());
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(expired, 3, squareLambda, xs), Result(error<IntVector, std::string>("deadline exceeded")));
+
+    // Cancelling after the last element was processed keeps the result.
+    const cancellation_token late;
+    std::atomic<std::size_t> calls(0);
+    const auto cancel_on_last = [&late, &calls](int x) {
+        if (++calls == xs.size()) {
+            late.cancel();
+        }
+        return x * x;
+    };
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(late, 1, cancel_on_last, xs), Result(ok<IntVector, std::string>({ 1, 4, 4, 9, 4 })));
+    REQUIRE(late.is_cancelled());
+
+    const auto generous = cancellation_token::with_timeout_ms(60 * 1000);
+    REQUIRE(generous.deadline().is_just());
+    REQUIRE_EQ(transform_parallelly_n_threads_cancellable(generous, 2, squareLambda, intList), ok<IntList, std::string>({ 1, 4, 4, 9, 4 }));
+}
+
+TEST_CASE("transform_test - parallel_cancellable")
+{
+    using namespace fplus;
+    typedef result<int, std::string> IntResult;
+    typedef result<IntVector, std::string> Result;
+    const cancellation_token token;
+    const cancellation_token cancelled;
+    cancelled.cancel();
+
+    REQUIRE_EQ(transform_parallelly_cancellable(token, squareLambda, xs), Result(ok<IntVector, std::string>({ 1, 4, 4, 9, 4 })));
+    REQUIRE_EQ(transform_parallelly_cancellable(cancelled, squareLambda, xs), Result(error<IntVector, std::string>("cancelled")));
+
+    REQUIRE_EQ(reduce_parallelly_cancellable(token, std::plus<int>(), 100, xs), IntResult(ok<int, std::string>(110)));
+    REQUIRE_EQ(reduce_parallelly_n_threads_cancellable(token, 2, std::plus<int>(), 100, IntVector()), IntResult(ok<int, std::string>(100)));
+    REQUIRE_EQ(reduce_parallelly_n_threads_cancellable(cancelled, 2, std::plus<int>(), 100, xs), IntResult(error<int, std::string>("cancelled")));
+    REQUIRE_EQ(reduce_1_parallelly_cancellable(token, std::plus<int>(), intList), IntResult(ok<int, std::string>(10)));
+    REQUIRE_EQ(reduce_1_parallelly_n_threads_cancellable(token, 3, std::plus<int>(), IntVector({ 7 })), IntResult(ok<int, std::string>(7)));
+    REQUIRE_EQ(reduce_1_parallelly_cancellable(cancelled, std::plus<int>(), xs), IntResult(error<int, std::string>("cancelled")));
+
+    REQUIRE_EQ(keep_if_parallelly_cancellable(token, is_even<int>, xs), Result(ok<IntVector, std::string>({ 2, 2, 2 })));
+    REQUIRE_EQ(keep_if_parallelly_n_threads_cancellable(token, 2, is_even<int>, xs), Result(ok<IntVector, std::string>({ 2, 2, 2 })));
+    REQUIRE_EQ(keep_if_parallelly_n_threads_cancellable(cancelled, 2, is_even<int>, xs), Result(error<IntVector, std::string>("cancelled")));
+}
+
+TEST_CASE("transform_test - transform_parallelly_n_threads_exceptions")
+{
+    using namespace fplus;
+    const auto throw_on_3 = [](int x) -> int {
+        if (x == 3) {
+            throw std::runtime_error("three");
+        }
+        return x;
+    };
+    bool caught = false;
+    try {
+        transform_parallelly_n_threads(2, throw_on_3, xs);
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "three";
+    }
+    REQUIRE(caught);
+
+    const auto failed = transform_parallelly_n_threads_result(2, throw_on_3, xs);
+    REQUIRE(is_error(failed));
+    caught = false;
+    try {
+        std::rethrow_exception(failed.unsafe_get_error());
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "three";
+    }
+    REQUIRE(caught);
+    REQUIRE(is_error(transform_parallelly_result(throw_on_3, xs)));
+
+    const auto succeeded = transform_parallelly_result(squareLambda, intList);
+    REQUIRE(is_ok(succeeded));
+    REQUIRE_EQ(succeeded.unsafe_get_ok(), IntList({ 1, 4, 4, 9, 4 }));
+    REQUIRE_EQ(transform_parallelly_n_threads_result(3, squareLambda, xs).unsafe_get_ok(), IntVector({ 1, 4, 4, 9, 4 }));
+}
+
 TEST_CASE("transform_test - transform_reduce")
 {
     const std::vector<int> v = { 1, 2, 3, 4, 5 };